@@ -83,14 +83,25 @@ TupleValue::~TupleValue()
     qDeleteAll(results);
 }
 
+const Result* TupleValue::findResult(const QString& variable) const
+{
+    // search backwards: if a field is repeated, the last one wins
+    for (int i = results.size() - 1; i >= 0; --i) {
+        const Result* result = results.at(i);
+        if (result->variable == variable)
+            return result;
+    }
+    return nullptr;
+}
+
 bool TupleValue::hasField(const QString& variable) const
 {
-    return results_by_name.contains(variable);
+    return findResult(variable);
 }
 
 const Value& TupleValue::operator[](const QString& variable) const
 {
-    Result* result = results_by_name.value(variable);
+    const Result* result = findResult(variable);
     if (!result)
         throw type_error();
     return *result->value;
@@ -25,6 +25,7 @@
 #define GDBMI_H
 
 #include <QString>
+#include <QList>
 #include <QMap>
 
 #include <stdexcept>
@@ -54,7 +55,9 @@ namespace KDevMI { namespace MI {
         DataListRegisterNames,
         DataListRegisterValues,
         DataReadMemory,
+        DataReadMemoryBytes,
         DataWriteMemory,
+        DataWriteMemoryBytes,
         DataWriteRegisterVariables,
 
         EnablePrettyPrinting,
@@ -272,8 +275,11 @@ namespace KDevMI { namespace MI {
         using Value::operator[];
         const Value& operator[](const QString& variable) const override;
 
+        /// Tuples have only a few fields, so they are looked up by scanning this list
         QList<Result*> results;
-        QMap<QString, Result*> results_by_name;
+
+    private:
+        const Result* findResult(const QString& variable) const;
     };
 
     struct ListValue : public Value
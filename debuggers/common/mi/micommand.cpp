@@ -201,9 +201,15 @@ QString MICommand::miCommand() const
         case DataReadMemory:
             command = QStringLiteral("data-read-memory");
             break;
+        case DataReadMemoryBytes:
+            command = QStringLiteral("data-read-memory-bytes");
+            break;
         case DataWriteMemory:
             command = QStringLiteral("data-write-memory");
             break;
+        case DataWriteMemoryBytes:
+            command = QStringLiteral("data-write-memory-bytes");
+            break;
         case DataWriteRegisterVariables:
             command = QStringLiteral("data-write-register-values");
             break;
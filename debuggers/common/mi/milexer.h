@@ -60,6 +60,13 @@ struct TokenStream
 
     QByteArray tokenText(int index = 0) const;
 
+    /// Like currentTokenText(), but points into the contents instead of copying them
+    inline const char* currentTokenData(int *length) const
+    {
+        *length = m_currentToken->length;
+        return m_contents.constData() + m_currentToken->position;
+    }
+
     inline int lineOffset(int line) const
     { return m_lines.at(line); }
 
@@ -307,7 +307,6 @@ bool MIParser::parseCSV(TupleValue& value,
             return false;
 
         value.results.append(result);
-        value.results_by_name.insert(result->variable, result);      
 
         if (m_lex->lookAhead() == ',')
             m_lex->nextToken();
@@ -323,58 +322,50 @@ bool MIParser::parseCSV(TupleValue& value,
 
 QString MIParser::parseStringLiteral()
 {
-    QByteArray messageByteArray = m_lex->currentTokenText();
-    QString message = QString::fromUtf8(messageByteArray.constData());
-
-    int length = message.length();
-    QString message2;
-    message2.reserve(length);
+    int length;
+    const char* data = m_lex->currentTokenData(&length);
     // The [1,length-1] range removes quotes without extra
     // call to 'mid'
-    int target_index = 0;
-    for(int i = 1, e = length-1; i != e; ++i)
-    {
-        int translated = -1;
-        if (message[i] == '\\')
+    const char* begin = data + 1;
+    const char* end = data + qMax(1, length - 1);
+
+    QString message;
+    if (!memchr(begin, '\\', end - begin)) {
+        // most literals have no escapes, decode them straight from the token
+        message = QString::fromUtf8(begin, end - begin);
+    } else {
+        // all escapes are plain ASCII, so they can be translated before decoding
+        QByteArray unescaped;
+        unescaped.reserve(end - begin);
+        for (const char* it = begin; it != end; ++it)
         {
-            if (i+1 < length)
+            char translated = 0;
+            if (*it == '\\' && it + 1 != end)
             {
                 // TODO: implement all the other escapes, maybe
-                if (message[i+1] == 'n')
-                {
-                    translated = '\n';
-                }
-                else if (message[i+1] == '\\')
-                {
-                    translated = '\\';
-                }
-                else if (message[i+1] == '"')
-                {
-                    translated = '"';
-                }
-                else if (message[i+1] == 't')
-                {
-                    translated = '\t';
-                }
-                else if (message[i+1] == 'r')
-                {
-                    translated = '\r';
+                switch (it[1]) {
+                    case 'n': translated = '\n'; break;
+                    case '\\': translated = '\\'; break;
+                    case '"': translated = '"'; break;
+                    case 't': translated = '\t'; break;
+                    case 'r': translated = '\r'; break;
+                    default: break;
                 }
             }
-        }
 
-        if (translated != -1)
-        {
-            message2[target_index++] = translated;
-            ++i;
-        }
-        else
-        {
-            message2[target_index++] = message[i];
+            if (translated)
+            {
+                unescaped += translated;
+                ++it;
+            }
+            else
+            {
+                unescaped += *it;
+            }
         }
+        message = QString::fromUtf8(unescaped);
     }
 
     m_lex->nextToken();
-    return message2;
+    return message;
 }
-
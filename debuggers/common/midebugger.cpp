@@ -123,17 +123,12 @@ void MIDebugger::readyReadStandardOutput()
 {
     process_->setReadChannel(QProcess::StandardOutput);
 
-    buffer_ += process_->readAll();
-    for (;;)
+    buffer_.append(process_->readAll());
+    /* In MI mode, all messages are exactly one line.
+       See if we have any complete lines in the buffer. */
+    QByteArray reply;
+    while (buffer_.takeLine(&reply))
     {
-        /* In MI mode, all messages are exactly one line.
-           See if we have any complete lines in the buffer. */
-        int i = buffer_.indexOf('\n');
-        if (i == -1)
-            break;
-        QByteArray reply(buffer_.left(i));
-        buffer_ = buffer_.mid(i+1);
-
         processLine(reply);
     }
 }
@@ -26,6 +26,8 @@
 #include "mi/mi.h"
 #include "mi/miparser.h"
 
+#include <util/linebuffer.h>
+
 #include <KProcess>
 
 #include <QByteArray>
@@ -144,7 +146,7 @@ protected:
 
     /** The unprocessed output from debugger. Output is
         processed as soon as we see newline. */
-    QByteArray buffer_;
+    KDevelop::LineBuffer buffer_;
 };
 
 }
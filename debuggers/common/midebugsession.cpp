@@ -30,6 +30,7 @@
 
 #include "debuglog.h"
 #include "midebugger.h"
+#include "mimemorycache.h"
 #include "mivariable.h"
 #include "mi/mi.h"
 #include "mi/micommand.h"
@@ -74,6 +75,7 @@ MIDebugSession::MIDebugSession(MIDebuggerPlugin *plugin)
     , m_hasCrashed(false)
     , m_sourceInitFile(true)
     , m_plugin(plugin)
+    , m_memoryCache(new MIMemoryCache(this))
 {
     // setup signals
     connect(m_procLineMaker, &ProcessLineMaker::receivedStdoutLines,
@@ -126,6 +128,11 @@ MIVariable* MIDebugSession::findVariableByVarobjName(const QString &varobjName)
     return m_allVariables.value(varobjName);
 }
 
+MIMemoryCache* MIDebugSession::memoryCache() const
+{
+    return m_memoryCache;
+}
+
 void MIDebugSession::markAllVariableDead()
 {
     for (auto i = m_allVariables.begin(), e = m_allVariables.end(); i != e; ++i)
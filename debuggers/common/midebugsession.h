@@ -53,6 +53,7 @@ class CommandQueue;
 
 class MIDebugger;
 class MIDebuggerPlugin;
+class MIMemoryCache;
 class MIVariable;
 class STTY;
 class MIDebugSession : public KDevelop::IDebugSession
@@ -225,6 +226,9 @@ public:
     MIVariable* findVariableByVarobjName(const QString &varobjName) const;
     void markAllVariableDead();
 
+    /// Inferior memory shared by the memory views of this session
+    MIMemoryCache* memoryCache() const;
+
 protected Q_SLOTS:
     virtual void slotDebuggerReady();
     virtual void slotDebuggerExited(bool abnormal, const QString &msg);
@@ -359,6 +363,8 @@ protected:
     QMap<QString, MIVariable*> m_allVariables;
 
     MIDebuggerPlugin *m_plugin;
+
+    MIMemoryCache *m_memoryCache;
 };
 
 template<class Handler>
@@ -0,0 +1,136 @@
+/*
+ * Cache of inferior memory for debuggers using MI
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "mimemorycache.h"
+
+#include "midebugsession.h"
+#include "mi/micommand.h"
+
+#include <QPointer>
+
+#include <cstring>
+
+using namespace KDevMI;
+using namespace KDevMI::MI;
+
+MIMemoryCache::MIMemoryCache(MIDebugSession* session)
+    : QObject(session)
+    , m_session(session)
+{
+    // the inferior may have changed anything while it was running
+    connect(session, &MIDebugSession::inferiorStopped, this, &MIMemoryCache::invalidate);
+}
+
+MIMemoryCache::~MIMemoryCache()
+{
+}
+
+QByteArray MIMemoryCache::page(quint64 pageAddress)
+{
+    auto it = m_pages.find(pageAddress);
+    if (it == m_pages.end()) {
+        fetch(pageAddress);
+        return {};
+    }
+    it->lastUse = ++m_useCounter;
+    return it->data;
+}
+
+void MIMemoryCache::fetch(quint64 pageAddress)
+{
+    if (m_pages.contains(pageAddress) || m_pending.contains(pageAddress)) {
+        return;
+    }
+    m_pending.insert(pageAddress);
+
+    QPointer<MIMemoryCache> guard(this);
+    const quint64 generation = m_generation;
+    m_session->addCommand(DataReadMemoryBytes,
+                          QStringLiteral("0x%1 %2").arg(pageAddress, 0, 16).arg(pageSize),
+                          [guard, pageAddress, generation](const ResultRecord& r) {
+                              if (guard) {
+                                  guard->pageRead(r, pageAddress, generation);
+                              }
+                          },
+                          CmdHandlesError);
+}
+
+void MIMemoryCache::pageRead(const ResultRecord& r, quint64 pageAddress, quint64 generation)
+{
+    if (generation != m_generation) {
+        return;
+    }
+    m_pending.remove(pageAddress);
+
+    QByteArray data(pageSize, 0);
+    // unreadable parts of the page are left out of the block list,
+    // an error means that nothing of the page can be read
+    if (r.reason != QLatin1String("error")) {
+        const Value& blocks = r[QStringLiteral("memory")];
+        for (int i = 0; i < blocks.size(); ++i) {
+            const Value& block = blocks[i];
+            const quint64 begin = block[QStringLiteral("begin")].literal().toULongLong(nullptr, 16);
+            const QByteArray contents = QByteArray::fromHex(block[QStringLiteral("contents")].literal().toLatin1());
+            if (begin < pageAddress || begin - pageAddress + contents.size() > quint64(pageSize)) {
+                continue;
+            }
+            memcpy(data.data() + (begin - pageAddress), contents.constData(), contents.size());
+        }
+    }
+
+    if (m_pages.size() >= maxPages) {
+        auto oldest = m_pages.begin();
+        for (auto it = m_pages.begin(); it != m_pages.end(); ++it) {
+            if (it->lastUse < oldest->lastUse) {
+                oldest = it;
+            }
+        }
+        m_pages.erase(oldest);
+    }
+    m_pages.insert(pageAddress, {data, ++m_useCounter});
+
+    emit pageFetched(pageAddress);
+}
+
+void MIMemoryCache::write(quint64 address, const QByteArray& data)
+{
+    m_session->addCommand(DataWriteMemoryBytes,
+                          QStringLiteral("0x%1 %2").arg(address, 0, 16).arg(QString::fromLatin1(data.toHex())));
+
+    for (int i = 0; i < data.size();) {
+        const quint64 byteAddress = address + i;
+        const quint64 pageAddress = byteAddress - byteAddress % pageSize;
+        const int offset = int(byteAddress - pageAddress);
+        const int length = qMin(data.size() - i, pageSize - offset);
+        auto it = m_pages.find(pageAddress);
+        if (it != m_pages.end()) {
+            memcpy(it->data.data() + offset, data.constData() + i, length);
+        }
+        i += length;
+    }
+}
+
+void MIMemoryCache::invalidate()
+{
+    ++m_generation;
+    m_pages.clear();
+    m_pending.clear();
+
+    emit invalidated();
+}
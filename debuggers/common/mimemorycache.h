@@ -0,0 +1,97 @@
+/*
+ * Cache of inferior memory for debuggers using MI
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVELOP_MI_MEMORYCACHE_H
+#define KDEVELOP_MI_MEMORYCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+namespace KDevMI {
+
+namespace MI {
+struct ResultRecord;
+}
+
+class MIDebugSession;
+
+/**
+ * Pages of inferior memory, fetched on demand with -data-read-memory-bytes.
+ *
+ * The pages are shared by all memory views of the session. They are dropped
+ * when the inferior stops, as it may have changed the memory meanwhile, and
+ * only the most recently used pages are kept.
+ */
+class MIMemoryCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Number of bytes fetched with one command, pages start at multiples of it
+    static const int pageSize = 64 * 1024;
+    /// Number of pages kept in the cache
+    static const int maxPages = 256;
+
+    explicit MIMemoryCache(MIDebugSession* session);
+    ~MIMemoryCache() override;
+
+    /**
+     * @return the page starting at @p pageAddress, or an empty array if it is not cached
+     *
+     * A missing page gets fetched, pageFetched() is emitted once it is there.
+     * Parts of a page that cannot be read are zero.
+     */
+    QByteArray page(quint64 pageAddress);
+
+    /// Fetches the page starting at @p pageAddress, unless it is cached or being fetched already
+    void fetch(quint64 pageAddress);
+
+    /// Writes @p data to the inferior at @p address and updates the cached pages
+    void write(quint64 address, const QByteArray& data);
+
+public Q_SLOTS:
+    /// Drops all pages, the pages being fetched are fetched again when they are used
+    void invalidate();
+
+Q_SIGNALS:
+    void pageFetched(quint64 pageAddress);
+    void invalidated();
+
+private:
+    struct Page
+    {
+        QByteArray data;
+        quint64 lastUse;
+    };
+
+    void pageRead(const MI::ResultRecord& r, quint64 pageAddress, quint64 generation);
+
+    MIDebugSession* m_session;
+    QHash<quint64, Page> m_pages;
+    QSet<quint64> m_pending;
+    quint64 m_useCounter = 0;
+    /// Bumped by invalidate(), so that replies to older fetches are ignored
+    quint64 m_generation = 0;
+};
+
+} // end of namespace KDevMI
+
+#endif // KDEVELOP_MI_MEMORYCACHE_H
@@ -246,13 +246,14 @@ private:
 void MIVariable::fetchMoreChildren()
 {
     int c = childItems.size();
+    const int step = qBound(int(fetchStep), c, int(maxFetchStep));
     // FIXME: should not even try this if app is not started.
     // Probably need to disable open, or something
     if (sessionIsAlive()) {
         debugSession->addCommand(VarListChildren,
                                  QStringLiteral("--all-values \"%1\" %2 %3")
                                  //   fetch    from ..    to ..
-                                 .arg(varobj_).arg(c).arg(c + fetchStep),
+                                 .arg(varobj_).arg(c).arg(c + step),
                                  new FetchMoreChildrenHandler(this, debugSession));
     }
 }
@@ -81,9 +81,12 @@ protected: // Internal
 
     QPointer<MIDebugSession> debugSession;
 
-    // How many children should be fetched in one
-    // increment.
+    // How many children should be fetched in the first
+    // increment. Each further increment fetches as many children
+    // as are already shown, up to maxFetchStep, so that big
+    // containers don't need one round trip per few elements.
     static const int fetchStep = 5;
+    static const int maxFetchStep = 100;
 };
 } // end of KDevMI
 
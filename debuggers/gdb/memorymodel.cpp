@@ -0,0 +1,245 @@
+/*
+ * Okteta model of inferior memory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "memorymodel.h"
+
+#include "mimemorycache.h"
+
+#include <Okteta/ArrayChangeMetricsList>
+
+using namespace KDevMI;
+using namespace KDevMI::GDB;
+
+MemoryModel::MemoryModel(QObject* parent)
+    : Okteta::AbstractByteArrayModel(parent)
+{
+}
+
+MemoryModel::~MemoryModel()
+{
+}
+
+void MemoryModel::setRange(MIMemoryCache* cache, quint64 start, Okteta::Size size)
+{
+    if (m_cache) {
+        disconnect(m_cache, nullptr, this, nullptr);
+    }
+    m_cache = cache;
+    if (m_cache) {
+        connect(m_cache, &MIMemoryCache::pageFetched, this, &MemoryModel::pageFetched);
+        connect(m_cache, &MIMemoryCache::invalidated, this, &MemoryModel::cacheInvalidated);
+    }
+
+    const Okteta::Size oldSize = m_size;
+    m_start = start;
+    m_size = size;
+    m_edits.clear();
+    m_currentPage.clear();
+
+    setModified(false);
+    emit contentsChanged(Okteta::ArrayChangeMetricsList()
+                         << Okteta::ArrayChangeMetrics::asReplacement(0, oldSize, m_size));
+}
+
+quint64 MemoryModel::start() const
+{
+    return m_start;
+}
+
+void MemoryModel::setScrollingForward(bool forward)
+{
+    m_scrollingForward = forward;
+}
+
+void MemoryModel::writeChanges()
+{
+    if (!m_cache) {
+        return;
+    }
+
+    // write runs of adjacent bytes with one command each
+    QByteArray run;
+    Okteta::Address runStart = 0;
+    for (auto it = m_edits.constBegin(); it != m_edits.constEnd(); ++it) {
+        if (!run.isEmpty() && it.key() != runStart + run.size()) {
+            m_cache->write(m_start + runStart, run);
+            run.clear();
+        }
+        if (run.isEmpty()) {
+            runStart = it.key();
+        }
+        run.append(char(it.value()));
+    }
+    if (!run.isEmpty()) {
+        m_cache->write(m_start + runStart, run);
+    }
+
+    // the cached pages hold the written bytes now
+    m_edits.clear();
+    m_currentPage.clear();
+    setModified(false);
+}
+
+Okteta::Byte MemoryModel::byte(Okteta::Address offset) const
+{
+    const auto edit = m_edits.constFind(offset);
+    if (edit != m_edits.constEnd()) {
+        return *edit;
+    }
+    if (!m_cache) {
+        return 0;
+    }
+
+    const quint64 address = m_start + offset;
+    const quint64 pageAddress = address - address % MIMemoryCache::pageSize;
+    if (m_currentPage.isEmpty() || pageAddress != m_currentPageAddress) {
+        m_currentPageAddress = pageAddress;
+        m_currentPage = m_cache->page(pageAddress);
+
+        // the view reads line by line, so this is reached about once per page and repaint
+        if (m_scrollingForward) {
+            if (pageAddress + MIMemoryCache::pageSize < m_start + quint64(m_size)) {
+                m_cache->fetch(pageAddress + MIMemoryCache::pageSize);
+            }
+        } else if (pageAddress > m_start) {
+            m_cache->fetch(pageAddress - MIMemoryCache::pageSize);
+        }
+    }
+
+    if (m_currentPage.isEmpty()) {
+        return 0;
+    }
+    return Okteta::Byte(m_currentPage.at(int(address - pageAddress)));
+}
+
+Okteta::Size MemoryModel::size() const
+{
+    return m_size;
+}
+
+bool MemoryModel::isReadOnly() const
+{
+    return m_readOnly;
+}
+
+bool MemoryModel::isModified() const
+{
+    return m_modified;
+}
+
+Okteta::Size MemoryModel::replace(const Okteta::AddressRange& removeRange,
+                                  const Okteta::Byte* insertData, int insertLength)
+{
+    // the memory can only be overwritten
+    if (m_readOnly || !removeRange.isValid() || removeRange.width() != insertLength
+        || removeRange.start() < 0 || removeRange.end() >= m_size) {
+        return 0;
+    }
+
+    for (int i = 0; i < insertLength; ++i) {
+        m_edits[removeRange.start() + i] = insertData[i];
+    }
+    emitChanged(removeRange.start(), insertLength);
+    setModified(true);
+    return insertLength;
+}
+
+bool MemoryModel::swap(Okteta::Address firstStart, const Okteta::AddressRange& secondRange)
+{
+    Q_UNUSED(firstStart);
+    Q_UNUSED(secondRange);
+    return false;
+}
+
+Okteta::Size MemoryModel::fill(Okteta::Byte fillByte, Okteta::Address offset, Okteta::Size fillLength)
+{
+    if (m_readOnly || offset < 0 || offset >= m_size) {
+        return 0;
+    }
+    if (fillLength < 0 || fillLength > m_size - offset) {
+        fillLength = m_size - offset;
+    }
+
+    for (Okteta::Size i = 0; i < fillLength; ++i) {
+        m_edits[offset + i] = fillByte;
+    }
+    emitChanged(offset, fillLength);
+    setModified(true);
+    return fillLength;
+}
+
+void MemoryModel::setByte(Okteta::Address offset, Okteta::Byte byte)
+{
+    if (m_readOnly || offset < 0 || offset >= m_size) {
+        return;
+    }
+
+    m_edits[offset] = byte;
+    emitChanged(offset, 1);
+    setModified(true);
+}
+
+void MemoryModel::setModified(bool modified)
+{
+    if (m_modified == modified) {
+        return;
+    }
+    m_modified = modified;
+    emit modifiedChanged(modified);
+}
+
+void MemoryModel::setReadOnly(bool isReadOnly)
+{
+    if (m_readOnly == isReadOnly) {
+        return;
+    }
+    m_readOnly = isReadOnly;
+    emit readOnlyChanged(isReadOnly);
+}
+
+void MemoryModel::pageFetched(quint64 pageAddress)
+{
+    const quint64 end = m_start + quint64(m_size);
+    const quint64 pageEnd = pageAddress + MIMemoryCache::pageSize;
+    if (pageEnd <= m_start || pageAddress >= end) {
+        return;
+    }
+
+    if (pageAddress == m_currentPageAddress) {
+        m_currentPage.clear();
+    }
+    const quint64 first = qMax(pageAddress, m_start);
+    const quint64 last = qMin(pageEnd, end);
+    emitChanged(Okteta::Address(first - m_start), Okteta::Size(last - first));
+}
+
+void MemoryModel::cacheInvalidated()
+{
+    // the view reads the shown bytes again, which fetches their pages
+    m_currentPage.clear();
+    if (m_size > 0) {
+        emitChanged(0, m_size);
+    }
+}
+
+void MemoryModel::emitChanged(Okteta::Address offset, Okteta::Size length)
+{
+    emit contentsChanged(Okteta::ArrayChangeMetricsList()
+                         << Okteta::ArrayChangeMetrics::asReplacement(offset, length, length));
+}
@@ -0,0 +1,97 @@
+/*
+ * Okteta model of inferior memory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef MEMORYMODEL_H
+#define MEMORYMODEL_H
+
+#include <Okteta/AbstractByteArrayModel>
+
+#include <QByteArray>
+#include <QMap>
+#include <QPointer>
+
+namespace KDevMI
+{
+class MIMemoryCache;
+
+namespace GDB
+{
+    /**
+     * Serves a range of inferior memory to the Okteta view.
+     *
+     * Only the pages the view asks for are fetched from the memory cache of
+     * the session, so ranges of hundreds of megabytes can be browsed. Bytes of
+     * pages that are still being fetched read as zero until the page arrives.
+     * Edits are kept in the model until writeChanges() is called.
+     */
+    class MemoryModel : public Okteta::AbstractByteArrayModel
+    {
+        Q_OBJECT
+    public:
+        explicit MemoryModel(QObject* parent = nullptr);
+        ~MemoryModel() override;
+
+        /// Shows @p size bytes starting at @p start, read through @p cache
+        void setRange(MIMemoryCache* cache, quint64 start, Okteta::Size size);
+        quint64 start() const;
+
+        /// Tells in which direction the view scrolls, the next page in that direction gets prefetched
+        void setScrollingForward(bool forward);
+
+        /// Writes the edited bytes to the inferior
+        void writeChanges();
+
+    public: // Okteta::AbstractByteArrayModel API
+        Okteta::Byte byte(Okteta::Address offset) const override;
+        Okteta::Size size() const override;
+        bool isReadOnly() const override;
+        bool isModified() const override;
+
+        Okteta::Size replace(const Okteta::AddressRange& removeRange,
+                             const Okteta::Byte* insertData, int insertLength) override;
+        bool swap(Okteta::Address firstStart, const Okteta::AddressRange& secondRange) override;
+        Okteta::Size fill(Okteta::Byte fillByte, Okteta::Address offset = 0, Okteta::Size fillLength = -1) override;
+        void setByte(Okteta::Address offset, Okteta::Byte byte) override;
+
+        void setModified(bool modified) override;
+        void setReadOnly(bool isReadOnly) override;
+
+    private:
+        void pageFetched(quint64 pageAddress);
+        void cacheInvalidated();
+        void emitChanged(Okteta::Address offset, Okteta::Size length);
+
+        QPointer<MIMemoryCache> m_cache;
+        quint64 m_start = 0;
+        Okteta::Size m_size = 0;
+        bool m_readOnly = false;
+        bool m_modified = false;
+        bool m_scrollingForward = true;
+        /// Edited bytes by offset, not written to the inferior yet
+        QMap<Okteta::Address, Okteta::Byte> m_edits;
+
+        // the page last read by byte(), most calls are for the same page
+        mutable quint64 m_currentPageAddress = 0;
+        mutable QByteArray m_currentPage;
+    };
+
+} // end of namespace GDB
+} // end of namespace KDevMI
+
+#endif
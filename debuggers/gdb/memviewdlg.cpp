@@ -17,15 +17,17 @@
 
 #include "dbgglobal.h"
 #include "debugsession.h"
+#include "memorymodel.h"
 #include "mi/micommand.h"
+#include "mimemorycache.h"
 
 #include <interfaces/icore.h>
 #include <interfaces/idebugcontroller.h>
 
 #include <KLocalizedString>
+#include <KMessageBox>
 
 #include <Okteta/ByteArrayColumnView>
-#include <Okteta/ByteArrayModel>
 
 #include <QAction>
 #include <QContextMenuEvent>
@@ -34,10 +36,12 @@
 #include <QDialogButtonBox>
 #include <QMenu>
 #include <QPushButton>
+#include <QScrollBar>
 #include <QToolBox>
 #include <QVBoxLayout>
 
 #include <cctype>
+#include <climits>
 
 using KDevMI::MI::CommandType;
 
@@ -135,7 +139,7 @@ void MemoryView::initWidget()
     QVBoxLayout *l = new QVBoxLayout(this);
     l->setContentsMargins(0, 0, 0, 0);
 
-    m_memViewModel = new Okteta::ByteArrayModel(0, -1, this);
+    m_memViewModel = new MemoryModel(this);
     m_memViewView = new Okteta::ByteArrayColumnView(this);
     m_memViewView->setByteArrayModel(m_memViewModel);
 
@@ -143,7 +147,6 @@ void MemoryView::initWidget()
     m_memViewView->setReadOnly(false);
     m_memViewView->setOverwriteMode(true);
     m_memViewView->setOverwriteOnly(true);
-    m_memViewModel->setAutoDelete(false);
 
     m_memViewView->setValueCoding( Okteta::ByteArrayColumnView::HexadecimalCoding );
     m_memViewView->setNoOfGroupedBytes(4);
@@ -174,6 +177,9 @@ void MemoryView::initWidget()
             this,
             &MemoryView::slotEnableOrDisable);
 
+    connect(m_memViewView->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &MemoryView::scrolled);
+
     l->addWidget(m_memViewView);
 }
 
@@ -205,57 +211,77 @@ void MemoryView::slotChangeMemoryRange()
     session->addCommand(new MI::ExpressionValueCommand(amount, this, &MemoryView::sizeComputed));
 }
 
-void MemoryView::sizeComputed(const QString& size)
+/// Largest range shown at once, Okteta addresses bytes with an int
+static const quint64 maxMemorySize = INT_MAX;
+
+void MemoryView::sizeComputed(const QString& value)
 {
+    // the value may come with a type suffix or in hex, depending on the expression
+    bool ok = false;
+    const QString number = value.section(QLatin1Char(' '), 0, 0);
+    quint64 size = number.toULongLong(&ok, 0);
+    if (!ok || size == 0) {
+        KMessageBox::error(this,
+                           i18n("Cannot show memory: \"%1\" is not a valid amount.", value),
+                           i18n("Memory view"));
+        return;
+    }
+
+    if (size > maxMemorySize) {
+        KMessageBox::information(this,
+                                 i18np("Only the first byte of the range is shown.",
+                                       "Only the first %1 bytes of the range are shown.",
+                                       maxMemorySize),
+                                 i18n("Memory view"));
+        size = maxMemorySize;
+    }
+
     DebugSession *session = qobject_cast<DebugSession*>(
         KDevelop::ICore::self()->debugController()->currentSession());
     if (!session) return;
 
-    session->addCommand(MI::DataReadMemory,
-            QStringLiteral("%1 x 1 1 %2")
-                .arg(m_rangeSelector->startAddressLineEdit->text())
-                .arg(size),
-            this,
-            &MemoryView::memoryRead);
-}
-
-void MemoryView::memoryRead(const MI::ResultRecord& r)
-{
-    const MI::Value& content = r[QStringLiteral("memory")][0][QStringLiteral("data")];
-    bool startStringConverted;
-    m_memStart = r[QStringLiteral("addr")].literal().toULongLong(&startStringConverted, 16);
-    m_memData.resize(content.size());
-
+    m_memAmount = int(size);
     m_memStartStr = m_rangeSelector->startAddressLineEdit->text();
     m_memAmountStr = m_rangeSelector->amountLineEdit->text();
 
-    setWindowTitle(i18np("%2 (1 byte)","%2 (%1 bytes)",m_memData.size(),m_memStartStr));
-    emit captionChanged(windowTitle());
-
-    for(int i = 0; i < content.size(); ++i)
-    {
-        m_memData[i] = content[i].literal().toInt(0, 16);
-    }
-
-    m_memViewModel->setData(reinterpret_cast<Okteta::Byte*>(m_memData.data()), m_memData.size());
+    // resolve the address once, so that all pages are read relative to the same start
+    session->addCommand(new MI::ExpressionValueCommand(
+        QStringLiteral("(void*)(%1)").arg(m_memStartStr), this, &MemoryView::startComputed));
 
     slotHideRangeDialog();
 }
 
-
-void MemoryView::memoryEdited(int start, int end)
+void MemoryView::startComputed(const QString& value)
 {
+    // pointer values come as "0x601040 <symbol>"
+    bool ok = false;
+    const quint64 start = value.section(QLatin1Char(' '), 0, 0).toULongLong(&ok, 16);
+    if (!ok) {
+        KMessageBox::error(this,
+                           i18n("Cannot show memory: \"%1\" is not a valid address.", value),
+                           i18n("Memory view"));
+        return;
+    }
+
+    setWindowTitle(i18np("%2 (1 byte)","%2 (%1 bytes)",m_memAmount,m_memStartStr));
+    emit captionChanged(windowTitle());
+
     DebugSession *session = qobject_cast<DebugSession*>(
         KDevelop::ICore::self()->debugController()->currentSession());
     if (!session) return;
 
-    for(int i = start; i <= end; ++i)
-    {
-        session->addCommand(MI::GdbSet,
-                QStringLiteral("*(char*)(%1 + %2) = %3")
-                    .arg(m_memStart)
-                    .arg(i)
-                    .arg(QString::number(m_memData[i])));
+    // the model fetches the pages as the view shows them
+    m_scrollPosition = 0;
+    m_memViewModel->setScrollingForward(true);
+    m_memViewModel->setRange(session->memoryCache(), start, m_memAmount);
+    m_memViewView->setModified(false);
+}
+
+void MemoryView::scrolled(int position)
+{
+    if (position != m_scrollPosition) {
+        m_memViewModel->setScrollingForward(position > m_scrollPosition);
+        m_scrollPosition = position;
     }
 }
 
@@ -270,7 +296,7 @@ void MemoryView::contextMenuEvent(QContextMenuEvent *e)
 
     QAction* reload = menu.addAction(i18n("&Reload"));
     reload->setIcon(QIcon::fromTheme(QStringLiteral("view-refresh")));
-    reload->setEnabled(app_running && !m_memData.isEmpty() );
+    reload->setEnabled(app_running && m_memViewModel->size() > 0);
 
     QActionGroup* formatGroup = nullptr;
     QActionGroup* groupingGroup = nullptr;
@@ -367,18 +393,14 @@ void MemoryView::contextMenuEvent(QContextMenuEvent *e)
 
     if (result == reload)
     {
-        // We use m_memStart and m_memAmount stored in this,
+        // We keep the resolved range of the model,
         // not textual m_memStartStr and m_memAmountStr,
         // because program position might have changes and expressions
         // are no longer valid.
         DebugSession *session = qobject_cast<DebugSession*>(
             KDevelop::ICore::self()->debugController()->currentSession());
-        if (session) {
-            session->addCommand(MI::DataReadMemory,
-                    QStringLiteral("%1 x 1 1 %2").arg(m_memStart).arg(m_memData.size()),
-                    this,
-                    &MemoryView::memoryRead);
-        }
+        if (session)
+            session->memoryCache()->invalidate();
     }
 
     if (result && formatGroup && formatGroup == result->actionGroup())
@@ -389,7 +411,7 @@ void MemoryView::contextMenuEvent(QContextMenuEvent *e)
 
     if (result == write)
     {
-        memoryEdited(0, m_memData.size());
+        m_memViewModel->writeChanges();
         m_memViewView->setModified(false);
     }
 
@@ -21,9 +21,6 @@
 
 #include <QWidget>
 
-namespace Okteta {
-class ByteArrayModel;
-}
 namespace Okteta {
 class ByteArrayColumnView;
 }
@@ -43,6 +40,7 @@ namespace GDB
     class MemoryView;
     class GDBController;
     class MemoryRangeSelector;
+    class MemoryModel;
 
     class MemoryViewerWidget : public QWidget
     {
@@ -78,15 +76,15 @@ namespace GDB
 
     private: // Callbacks
         void sizeComputed(const QString& value);
-
-        void memoryRead(const MI::ResultRecord& r);
+        void startComputed(const QString& value);
+        /** Tells the model in which direction the view scrolls, so that it prefetches the memory ahead. */
+        void scrolled(int position);
 
         // Returns true is we successfully created the memoryView, and
         // can work.
         bool isOk() const;
 
     private Q_SLOTS:
-        void memoryEdited(int start, int end);
         /** Informs the view about changes in debugger state.
          *  Allows view to disable itself when debugger is not running. */
         void slotStateChanged(DBGStateFlags oldState, DBGStateFlags newState);
@@ -103,13 +101,14 @@ namespace GDB
         void initWidget();
 
         MemoryRangeSelector* m_rangeSelector;
-        Okteta::ByteArrayModel *m_memViewModel;
+        MemoryModel *m_memViewModel;
         Okteta::ByteArrayColumnView *m_memViewView;
 
-        quintptr m_memStart;
         QString m_memStartStr, m_memAmountStr;
-        QByteArray m_memData;
+        /// Size of the range being resolved, capped to what Okteta can address
+        int m_memAmount = 0;
         int m_debuggerState;
+        int m_scrollPosition = 0;
 
     private Q_SLOTS:
         void currentSessionChanged(KDevelop::IDebugSession* session);
@@ -1246,6 +1246,52 @@ void GdbTest::testVariablesWatchesQuotes()
     WAIT_FOR_STATE(session, DebugSession::EndedState);
 }
 
+void GdbTest::testVariablesWatchesFetchMore()
+{
+    TestDebugSession *session = new TestDebugSession;
+    session->variableController()->setAutoUpdate(KDevelop::IVariableController::UpdateWatches);
+
+    TestLaunchConfiguration cfg;
+
+    breakpoints()->addCodeBreakpoint(QUrl::fromLocalFile(debugeeFileName), 38);
+    QVERIFY(session->startDebugging(&cfg, m_iface));
+    WAIT_FOR_STATE_AND_IDLE(session, DebugSession::PausedState);
+
+    // a char[50], more children than the first pages of 5, 5 and 10 children hold
+    const QString testString(49, QLatin1Char('x'));
+    variableCollection()->watches()->add('"' + testString + '"');
+    QTest::qWait(300);
+
+    QModelIndex i = variableCollection()->index(0, 0);
+    QCOMPARE(variableCollection()->rowCount(i), 1);
+    QModelIndex testStr = variableCollection()->index(0, 0, i);
+    COMPARE_DATA(variableCollection()->index(0, 1, i), "[50]");
+    COMPARE_DATA(variableCollection()->index(0, 0, testStr), "...");
+
+    // each page is as big as the children shown so far, starting with 5
+    variableCollection()->expanded(testStr);
+    QTest::qWait(100);
+    const int fetched[] = {5, 10, 20, 40};
+    for (int count : fetched) {
+        QCOMPARE(variableCollection()->rowCount(testStr), count + 1);
+        COMPARE_DATA(variableCollection()->index(count - 1, 0, testStr), QString::number(count - 1));
+        COMPARE_DATA(variableCollection()->index(count - 1, 1, testStr), "120 'x'");
+        COMPARE_DATA(variableCollection()->index(count, 0, testStr), "...");
+
+        variableCollection()->clicked(variableCollection()->index(count, 0, testStr));
+        QTest::qWait(100);
+    }
+
+    // the last page holds the remaining children and there is nothing more to fetch
+    QCOMPARE(variableCollection()->rowCount(testStr), 50);
+    COMPARE_DATA(variableCollection()->index(48, 1, testStr), "120 'x'");
+    COMPARE_DATA(variableCollection()->index(49, 0, testStr), "49");
+    COMPARE_DATA(variableCollection()->index(49, 1, testStr), "0 '\\000'");
+
+    session->run();
+    WAIT_FOR_STATE(session, DebugSession::EndedState);
+}
+
 void GdbTest::testVariablesWatchesTwoSessions()
 {
     TestDebugSession *session = new TestDebugSession;
@@ -69,6 +69,7 @@ private Q_SLOTS:
     void testVariablesLocalsStruct();
     void testVariablesWatches();
     void testVariablesWatchesQuotes();
+    void testVariablesWatchesFetchMore();
     void testVariablesWatchesTwoSessions();
     void testVariablesStopDebugger();
     void testVariablesStartSecondSession();
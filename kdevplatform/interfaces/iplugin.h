@@ -74,6 +74,7 @@ struct ProjectConfigOptions;
  * X-KDevelop-Category=
  * X-KDevelop-Mode=GUI
  * X-KDevelop-LoadMode=
+ * X-KDevelop-Deferred=
  * X-KDevelop-Languages=
  * X-KDevelop-SupportedMimeTypes=
  * X-KDevelop-Interfaces=
@@ -119,6 +120,9 @@ struct ProjectConfigOptions;
  * explanation) (required);
  * - <i>X-KDevelop-LoadMode</i> can be set to AlwaysOn in which case the plugin will
  *   never be unloaded even if requested via the API. (optional);
+ * - <i>X-KDevelop-Deferred</i> can be set to true for global plugins which are not needed
+ *   to bring up the main window. They are loaded after the startup, or earlier when one of
+ *   their interfaces is requested. (optional);
  *
  * Plugin scope can be either:
  * - Global
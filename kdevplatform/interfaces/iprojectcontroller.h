@@ -23,6 +23,7 @@ Boston, MA 02110-1301, USA.
 
 #include <QObject>
 #include <QList>
+#include <QSet>
 #include <QUrl>
 
 #include "interfacesexport.h"
@@ -31,6 +32,7 @@ namespace KDevelop
 {
 
 class IProject;
+class IndexedString;
 class ProjectBuildSetModel;
 class ProjectModel;
 class ProjectBaseItem;
@@ -151,6 +153,13 @@ public Q_SLOTS:
     /// Schedules all files of the @p project for reparsing by @see BackgroundParser
     virtual void reparseProject( IProject* project, bool ForceUpdate = false ) = 0;
 
+    /**
+     * Schedules only the given @p files of the @p project for reparsing by @see BackgroundParser
+     *
+     * Unlike reparseProject(), this does not stop a reparse of the @p project that is still running.
+     */
+    virtual void reparseFiles( IProject* project, const QSet<IndexedString>& files, bool forceUpdate = false ) = 0;
+
 //     virtual void changeCurrentProject( KDevelop::ProjectBaseItem* ) = 0;
 
 Q_SIGNALS:
@@ -67,6 +67,11 @@ ParseProjectJob::~ParseProjectJob() {
 }
 
 ParseProjectJob::ParseProjectJob(IProject* project, bool forceUpdate)
+    : ParseProjectJob(project, project->fileSet(), forceUpdate)
+{
+}
+
+ParseProjectJob::ParseProjectJob(IProject* project, const QSet<IndexedString>& files, bool forceUpdate)
     : d(new ParseProjectJobPrivate(project, forceUpdate))
 {
     connect(project, &IProject::destroyed, this, &ParseProjectJob::deleteNow);
@@ -75,12 +80,12 @@ ParseProjectJob::ParseProjectJob(IProject* project, bool forceUpdate)
         // In case we don't want to parse the whole project, still add all currently open files that belong to the project to the background-parser
         foreach (auto document, ICore::self()->documentController()->openDocuments()) {
             const auto path = IndexedString(document->url());
-            if (project->fileSet().contains(path)) {
+            if (files.contains(path)) {
                 d->filesToParse.insert(path);
             }
         }
     } else {
-        d->filesToParse = project->fileSet();
+        d->filesToParse = files;
     }
 
     setCapabilities(Killable);
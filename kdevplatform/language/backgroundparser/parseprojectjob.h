@@ -19,6 +19,8 @@
 #ifndef KDEVPLATFORM_PARSEPROJECTJOB_H
 #define KDEVPLATFORM_PARSEPROJECTJOB_H
 
+#include <QSet>
+
 #include <kjob.h>
 #include <serialization/indexedstring.h>
 #include <language/languageexport.h>
@@ -34,6 +36,8 @@ class KDEVPLATFORMLANGUAGE_EXPORT ParseProjectJob : public KJob
     Q_OBJECT
 public:
     explicit ParseProjectJob(KDevelop::IProject* project, bool forceUpdate = false );
+    ///Parses only the given @p files of the @p project
+    ParseProjectJob(KDevelop::IProject* project, const QSet<KDevelop::IndexedString>& files, bool forceUpdate = false);
     ~ParseProjectJob() override;
     void start() override;
     bool doKill() override;
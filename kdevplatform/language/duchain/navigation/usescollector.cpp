@@ -37,6 +37,10 @@
 #include <codegen/coderepresentation.h>
 #include <KLocalizedString>
 
+#include <QFile>
+#include <QFutureWatcher>
+#include <QtConcurrentFilter>
+
 using namespace KDevelop;
 
 ///@todo make this language-neutral
@@ -86,6 +90,14 @@ void allImportedFiles(ParsingEnvironmentFilePointer file, QSet<IndexedString>& s
   }
 }
 
+///@return whether the file at @p url contains @p identifier, reading it from disk
+static bool fileContains(const IndexedString& url, const QString& identifier) {
+  QFile file(url.toUrl().toLocalFile());
+  if(!file.open(QIODevice::ReadOnly))
+    return false;
+  return QString::fromLocal8Bit(file.readAll()).contains(identifier);
+}
+
 void UsesCollector::setCollectConstructors(bool process) {
   m_collectConstructors = process;
 }
@@ -107,7 +119,20 @@ QList<IndexedDeclaration> UsesCollector::declarations() {
 }
 
 bool UsesCollector::isReady() const {
-  return m_waitForUpdate.size() == m_updateReady.size();
+  return !m_grepWatcher && m_waitForUpdate.size() == m_updateReady.size();
+}
+
+void UsesCollector::cancel() {
+  if(m_cancelled)
+    return;
+  m_cancelled = true;
+  if(m_grepWatcher)
+    m_grepWatcher->cancel();
+  ICore::self()->languageController()->backgroundParser()->revertAllRequests(this);
+}
+
+bool UsesCollector::isCancelled() const {
+  return m_cancelled;
 }
 
 bool UsesCollector::shouldRespectFile(IndexedString document) {
@@ -237,68 +262,109 @@ void UsesCollector::startCollecting() {
         if(checker(file))
           collected.insert(file);
 
-        {
-          QSet<ParsingEnvironmentFile*> filteredCollected;
-          QMap<IndexedString, bool> grepCache;
-          // Filter the collected files by performing a grep
-          foreach(ParsingEnvironmentFile* file, collected)
-          {
-            IndexedString url = file->url();
-            QMap< IndexedString, bool >::iterator grepCacheIt = grepCache.find(url);
-            if(grepCacheIt == grepCache.end())
-            {
-              CodeRepresentation::Ptr repr = KDevelop::createCodeRepresentation( url );
-              if(repr)
-              {
-                QVector<KTextEditor::Range> found = repr->grep(decl->identifier().identifier().str());
-                grepCacheIt = grepCache.insert(url, !found.isEmpty());
-              }
+        m_declarationUrl = decl->url();
+
+        // Filter the collected files by performing a grep. Files open in an editor are searched right away,
+        // all others are read and searched in parallel on the thread pool. Collecting goes on in grepFinished(),
+        // so neither the UI nor the background parser wait for the files to be read.
+        const QString identifier = decl->identifier().identifier().str();
+        // Keep the environment-files alive while the lock is released
+        QSet<IndexedString> candidateUrls;
+        m_grepCandidates.clear();
+        foreach(ParsingEnvironmentFile* file, collected) {
+          m_grepCandidates << ParsingEnvironmentFilePointer(file);
+          candidateUrls << file->url();
+        }
+        lock.unlock();
+
+        m_grepMatches.clear();
+        QList<IndexedString> diskFiles;
+        if(!identifier.isEmpty()) {
+          foreach(const IndexedString& url, candidateUrls) {
+            if(artificialCodeRepresentationExists(url) || ICore::self()->documentController()->documentForUrl(url.toUrl())) {
+              CodeRepresentation::Ptr repr = KDevelop::createCodeRepresentation(url);
+              if(repr && !repr->grep(identifier).isEmpty())
+                m_grepMatches << url;
+            } else {
+              diskFiles << url;
             }
-            if(grepCacheIt.value())
-              filteredCollected << file;
           }
-          qCDebug(LANGUAGE) << "Collected contexts for full re-parse, before filtering: " << collected.size() << " after filtering: " << filteredCollected.size();
-          collected = filteredCollected;
         }
 
-        ///We have all importers now. However since we can tell parse-jobs to also update all their importers, we only need to
-        ///update the "root" top-contexts that open the whole set with their imports.
-        QSet<IndexedString> rootFiles;
-        QSet<IndexedString> allFiles;
-        foreach(ParsingEnvironmentFile* importer, collected) {
-          QSet<IndexedString> allImports;
-          QSet<ParsingEnvironmentFilePointer> visited;
-          allImportedFiles(ParsingEnvironmentFilePointer(importer), allImports, visited);
-          //Remove all files from the "root" set that are imported by this one
-          ///@todo more intelligent
-          rootFiles -= allImports;
-          allFiles += allImports;
-          allFiles.insert(importer->url());
-          rootFiles.insert(importer->url());
-        }
+        m_grepWatcher = new QFutureWatcher<IndexedString>(this);
+        connect(m_grepWatcher, &QFutureWatcher<IndexedString>::finished, this, &UsesCollector::grepFinished);
+        m_grepWatcher->setFuture(QtConcurrent::filtered(diskFiles, [identifier](const IndexedString& url) {
+          return fileContains(url, identifier);
+        }));
+    }else{
+        emit maximumProgressSignal(0);
+        maximumProgress(0);
+    }
+}
 
-        emit maximumProgressSignal(rootFiles.size());
-        maximumProgress(rootFiles.size());
+void UsesCollector::grepFinished() {
+    const QList<IndexedString> diskMatches = m_grepWatcher->future().results();
+    m_grepWatcher->deleteLater();
+    m_grepWatcher = nullptr;
 
-        //If we used the AllDeclarationsContextsAndUsesRecursive flag here, we would compute way too much. This way we only
-        //set the minimum-features selectively on the files we really require them on.
-        foreach(ParsingEnvironmentFile* file, collected)
-          m_staticFeaturesManipulated.insert(file->url());
-        m_staticFeaturesManipulated.insert(decl->url());
+    DUChainReadLocker lock(DUChain::lock());
+    // Release the environment-files while the lock is held
+    QList<ParsingEnvironmentFilePointer> candidates;
+    candidates.swap(m_grepCandidates);
 
-        foreach(const IndexedString &file, m_staticFeaturesManipulated)
-          ParseJob::setStaticMinimumFeatures(file, TopDUContext::AllDeclarationsContextsAndUses);
+    if (m_cancelled)
+      return;
+    if (!m_declaration.data()) {
+      qCDebug(LANGUAGE) << "declaration has become invalid";
+      return;
+    }
 
-        m_waitForUpdate = rootFiles;
+    m_grepMatches += diskMatches.toSet();
+    QSet<ParsingEnvironmentFile*> collected;
+    foreach(const ParsingEnvironmentFilePointer& file, candidates)
+    {
+      if(m_grepMatches.contains(file->url()))
+        collected << file.data();
+    }
+    m_grepMatches.clear();
+    qCDebug(LANGUAGE) << "Collected contexts for full re-parse, before filtering: " << candidates.size() << " after filtering: " << collected.size();
+
+    ///We have all importers now. However since we can tell parse-jobs to also update all their importers, we only need to
+    ///update the "root" top-contexts that open the whole set with their imports.
+    QSet<IndexedString> rootFiles;
+    QSet<IndexedString> allFiles;
+    foreach(ParsingEnvironmentFile* importer, collected) {
+      QSet<IndexedString> allImports;
+      QSet<ParsingEnvironmentFilePointer> visited;
+      allImportedFiles(ParsingEnvironmentFilePointer(importer), allImports, visited);
+      //Remove all files from the "root" set that are imported by this one
+      ///@todo more intelligent
+      rootFiles -= allImports;
+      allFiles += allImports;
+      allFiles.insert(importer->url());
+      rootFiles.insert(importer->url());
+    }
 
-        foreach(const IndexedString &file, rootFiles) {
-          qCDebug(LANGUAGE) << "updating root file:" << file.str();
-          DUChain::self()->updateContextForUrl(file, TopDUContext::AllDeclarationsContextsAndUses, this);
-        }
+    emit maximumProgressSignal(rootFiles.size());
+    maximumProgress(rootFiles.size());
 
-    }else{
-        emit maximumProgressSignal(0);
-        maximumProgress(0);
+    //If we used the AllDeclarationsContextsAndUsesRecursive flag here, we would compute way too much. This way we only
+    //set the minimum-features selectively on the files we really require them on.
+    foreach(ParsingEnvironmentFile* file, collected)
+      m_staticFeaturesManipulated.insert(file->url());
+    m_staticFeaturesManipulated.insert(m_declarationUrl);
+
+    foreach(const IndexedString &file, m_staticFeaturesManipulated)
+      ParseJob::setStaticMinimumFeatures(file, TopDUContext::AllDeclarationsContextsAndUses);
+
+    m_waitForUpdate = rootFiles;
+
+    //The top-contexts are loaded and updated by the background parser, which runs its jobs in parallel.
+    //Each one is only walked for uses in updateReady(), with the read lock held just for that context.
+
+    foreach(const IndexedString &file, rootFiles) {
+      qCDebug(LANGUAGE) << "updating root file:" << file.str();
+      DUChain::self()->updateContextForUrl(file, TopDUContext::AllDeclarationsContextsAndUses, this);
     }
 }
 
@@ -306,10 +372,15 @@ void UsesCollector::maximumProgress(uint max) {
   Q_UNUSED(max);
 }
 
-UsesCollector::UsesCollector(IndexedDeclaration declaration) : m_declaration(declaration), m_collectOverloads(true), m_collectDefinitions(true), m_collectConstructors(false), m_processDeclarations(true) {
+UsesCollector::UsesCollector(IndexedDeclaration declaration) : m_declaration(declaration), m_grepWatcher(nullptr), m_collectOverloads(true), m_collectDefinitions(true), m_collectConstructors(false), m_processDeclarations(true), m_cancelled(false) {
 }
 
 UsesCollector::~UsesCollector() {
+  if(m_grepWatcher) {
+    m_grepWatcher->cancel();
+    DUChainReadLocker lock(DUChain::lock());
+    m_grepCandidates.clear();
+  }
   ICore::self()->languageController()->backgroundParser()->revertAllRequests(this);
 
   foreach(const IndexedString &file, m_staticFeaturesManipulated)
@@ -324,6 +395,9 @@ void UsesCollector::progress(uint processed, uint total) {
 
 void UsesCollector::updateReady(KDevelop::IndexedString url, KDevelop::ReferencedTopDUContext topContext) {
 
+  if(m_cancelled)
+    return;
+
   DUChainReadLocker lock(DUChain::lock());
 
   if(!topContext) {
@@ -22,8 +22,11 @@
 #include <QObject>
 #include <QSet>
 #include <language/duchain/topducontext.h>
+#include <language/duchain/parsingenvironment.h>
 #include <serialization/indexedstring.h>
 
+template<typename T> class QFutureWatcher;
+
 namespace KDevelop {
     class IndexedDeclaration;
     ///A helper base-class for collecting the top-contexts that contain all uses of a declaration
@@ -50,6 +53,10 @@ namespace KDevelop {
             virtual bool shouldRespectFile(IndexedString url);
             
             bool isReady() const;
+
+            ///Stops collecting: pending updates are reverted, and processUses(..) is not called anymore.
+            void cancel();
+            bool isCancelled() const;
             
             ///If this is true, the complete overload-chain is computed, and the uses of all overloaded functions together
             ///are computed.
@@ -90,6 +97,8 @@ namespace KDevelop {
             void processUsesSignal(KDevelop::ReferencedTopDUContext);
         private Q_SLOTS:
             void updateReady(KDevelop::IndexedString url, KDevelop::ReferencedTopDUContext topContext);
+            ///Goes on collecting with the files that contain the identifier of the declaration
+            void grepFinished();
         private:
             ///Called with every top-context that can contain uses of the declaration, or if setProcessDeclarations(false)
             ///has not been called also with all contexts that contain declarations used as base for the search.
@@ -105,6 +114,14 @@ namespace KDevelop {
             virtual void progress(uint processed, uint max);
             
             IndexedDeclaration m_declaration;
+            IndexedString m_declarationUrl;
+
+            ///Searches the collected files that are not open in an editor
+            QFutureWatcher<IndexedString>* m_grepWatcher;
+            ///The collected files, kept alive while they are searched
+            QList<ParsingEnvironmentFilePointer> m_grepCandidates;
+            ///The collected files that are known to contain the identifier
+            QSet<IndexedString> m_grepMatches;
             QSet<IndexedString> m_waitForUpdate;
             QSet<IndexedString> m_updateReady;
             
@@ -124,6 +141,7 @@ namespace KDevelop {
             bool m_collectDefinitions;
             bool m_collectConstructors;
             bool m_processDeclarations;
+            bool m_cancelled;
     };
 }
 
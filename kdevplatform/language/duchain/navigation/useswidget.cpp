@@ -548,11 +548,17 @@ UsesWidget::~UsesWidget()
 {
     if (m_collector) {
         m_collector->setWidget(nullptr);
+        // Nobody else is interested in the results of our own collector
+        if (m_ownsCollector) {
+            m_collector->cancel();
+        }
     }
 }
 
 UsesWidget::UsesWidget(const IndexedDeclaration& declaration, QSharedPointer<UsesWidgetCollector> customCollector)
     : NavigatableWidgetList(true)
+    , m_progressBar(nullptr)
+    , m_ownsCollector(!customCollector)
 {
     DUChainReadLocker lock(DUChain::lock());
     setUpdatesEnabled(false);
@@ -567,6 +573,7 @@ UsesWidget::UsesWidget(const IndexedDeclaration& declaration, QSharedPointer<Use
 
     m_progressBar = new QProgressBar;
     addHeaderItem(m_progressBar);
+    redrawHeaderLine();
 
     if (!customCollector) {
         m_collector = QSharedPointer<UsesWidgetCollector>(new UsesWidget::UsesWidgetCollector(declaration));
@@ -588,9 +595,27 @@ void UsesWidget::redrawHeaderLine()
 
 const QString UsesWidget::headerLineText() const
 {
-  return i18np("1 use found", "%1 uses found", countAllUses()) + " &bull; "
+  QString text = i18np("1 use found", "%1 uses found", countAllUses()) + " &bull; "
               "<a href='expandAll'>[" + i18n("Expand all") + "]</a> &bull; "
               "<a href='collapseAll'>[" + i18n("Collapse all") + "]</a>";
+  if (m_progressBar) {
+    // Uses are still being collected
+    text += " &bull; <a href='cancel'>[" + i18n("Stop searching") + "]</a>";
+  }
+  return text;
+}
+
+void UsesWidget::finishProgress()
+{
+  if (!m_progressBar)
+    return;
+
+  setUpdatesEnabled(false);
+  delete m_progressBar;
+  m_progressBar = nullptr;
+  setShowHeader(false);
+  setUpdatesEnabled(true);
+  redrawHeaderLine();
 }
 
 unsigned int UsesWidget::countAllUses() const
@@ -621,6 +646,15 @@ void UsesWidget::headerLinkActivated(QString linkName)
   else if(linkName == QLatin1String("collapseAll")) {
     setAllExpanded(false);
   }
+  else if(linkName == QLatin1String("cancel")) {
+    if (m_ownsCollector) {
+      m_collector->cancel();
+    } else {
+      // a shared collector goes on for the others, just stop listening to it
+      m_collector->setWidget(nullptr);
+    }
+    finishProgress();
+  }
 }
 
 UsesWidget::UsesWidgetCollector::UsesWidgetCollector(IndexedDeclaration decl) : UsesCollector(decl), m_widget(nullptr) {
@@ -657,11 +691,7 @@ void UsesWidget::UsesWidgetCollector::progress(uint processed, uint total) {
     m_widget->m_progressBar->setValue(processed);
 
     if(processed == total) {
-      m_widget->setUpdatesEnabled(false);
-      delete m_widget->m_progressBar;
-      m_widget->m_progressBar = nullptr;
-      m_widget->setShowHeader(false);
-      m_widget->setUpdatesEnabled(true);
+      m_widget->finishProgress();
     }
   }else{
     qCWarning(LANGUAGE) << "progress() called too often";
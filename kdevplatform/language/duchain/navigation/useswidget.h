@@ -151,9 +151,12 @@ namespace KDevelop {
             void navigateDeclaration(KDevelop::IndexedDeclaration);
         private:
             const QString headerLineText() const;
+            ///Removes the progress-bar once all uses have been collected, or the search was cancelled
+            void finishProgress();
             QLabel* m_headerLine;
             QSharedPointer<UsesWidgetCollector> m_collector;
             QProgressBar* m_progressBar;
+            bool m_ownsCollector;
         public Q_SLOTS:
             void headerLinkActivated(QString linkName);
             void redrawHeaderLine();
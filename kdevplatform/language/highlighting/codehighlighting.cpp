@@ -23,12 +23,17 @@
 
 #include "codehighlighting.h"
 
+#include <QElapsedTimer>
+#include <QTimer>
+
 #include <KTextEditor/Document>
+#include <KTextEditor/View>
 
 #include "../../interfaces/icore.h"
 #include "../../interfaces/ilanguagecontroller.h"
 #include "../../interfaces/icompletionsettings.h"
 #include "../../util/foregroundlock.h"
+#include "../../util/texteditorhelpers.h"
 #include <debug.h>
 
 #include "../duchain/declaration.h"
@@ -51,17 +56,30 @@ using namespace KTextEditor;
 
 static const float highlightingZDepth = -500;
 
+// Maximum time in ms the foreground thread spends applying highlighting at once,
+// so that huge documents don't block the UI.
+static const int highlightingSliceTime = 10;
+// Number of ranges that are matched between two checks of the slice timer
+static const int highlightingSliceGranularity = 64;
+// Documents with more highlighted ranges only get moving ranges around the visible region
+static const int viewportHighlightingThreshold = 20000;
+// Number of lines above and below the visible region that are highlighted in such documents
+static const int viewportMarginLines = 300;
+
 #define ifDebug(x)
 
 namespace KDevelop {
 
-///@todo Don't highlighting everything, only what is visible on-demand
-
 CodeHighlighting::CodeHighlighting( QObject * parent )
-  : QObject(parent), m_localColorization(true), m_globalColorization(true), m_dataMutex(QMutex::Recursive)
+  : QObject(parent), m_applyScheduled(false), m_localColorization(true), m_globalColorization(true), m_dataMutex(QMutex::Recursive)
 {
   qRegisterMetaType<KDevelop::IndexedString>("KDevelop::IndexedString");
 
+  m_viewportTimer = new QTimer(this);
+  m_viewportTimer->setSingleShot(true);
+  m_viewportTimer->setInterval(50);
+  connect(m_viewportTimer, &QTimer::timeout, this, &CodeHighlighting::updateViewports);
+
   adaptToColorChanges();
 
   connect(ColorCache::self(), &ColorCache::colorsGotChanged,
@@ -152,7 +170,7 @@ bool CodeHighlighting::hasHighlighting(IndexedString url) const
   if(tracker)
   {
     QMutexLocker lock(&m_dataMutex);
-    return m_highlights.contains(tracker) && !m_highlights[tracker]->m_highlightedRanges.isEmpty();
+    return m_highlights.contains(tracker) && !m_highlights[tracker]->m_waiting.isEmpty();
   }
   return false;
 }
@@ -497,8 +515,10 @@ void CodeHighlighting::clearHighlightingForDocument(IndexedString document)
   if(m_highlights.contains(tracker))
   {
     disconnect(tracker, &DocumentChangeTracker::destroyed, this, &CodeHighlighting::trackerDestroyed);
-    qDeleteAll(m_highlights[tracker]->m_highlightedRanges);
-    delete m_highlights[tracker];
+    DocumentHighlighting* highlighting = m_highlights[tracker];
+    qDeleteAll(highlighting->m_highlightedRanges);
+    qDeleteAll(highlighting->m_oldRanges.begin() + highlighting->m_oldRangesPosition, highlighting->m_oldRanges.end());
+    delete highlighting;
     m_highlights.remove(tracker);
   }
 }
@@ -529,8 +549,12 @@ void CodeHighlighting::applyHighlighting(void* _highlighting)
 
   if(m_highlights.contains(tracker))
   {
-    oldHighlightedRanges = m_highlights[tracker]->m_highlightedRanges;
-    delete m_highlights[tracker];
+    DocumentHighlighting* previous = m_highlights[tracker];
+    oldHighlightedRanges = previous->m_highlightedRanges;
+    // The previous highlighting may not have been applied completely yet,
+    // then its unmatched ranges are still alive and sorted behind the applied ones
+    oldHighlightedRanges += previous->m_oldRanges.mid(previous->m_oldRangesPosition);
+    delete previous;
   }else{
     // we newly add this tracker, so add the connection
     // This can't use new style connect syntax since MovingInterface is not a QObject
@@ -539,58 +563,216 @@ void CodeHighlighting::applyHighlighting(void* _highlighting)
     connect(tracker->document(), SIGNAL(aboutToRemoveText(KTextEditor::Range)),
             this, SLOT(aboutToRemoveText(KTextEditor::Range)));
     connect(tracker, &DocumentChangeTracker::destroyed, this, &CodeHighlighting::trackerDestroyed);
+    connect(tracker->document(), &Document::viewCreated, this, &CodeHighlighting::viewCreated);
+    foreach (View* view, tracker->document()->views())
+      viewCreated(tracker->document(), view);
   }
 
+  // Keep the revision alive until all slices are applied. Viewport-only highlightings need it
+  // as long as they exist, to map the visible region back to the waiting ranges.
+  highlighting->m_revision = tracker->acquireRevision(highlighting->m_waitingRevision);
+  highlighting->m_oldRanges = oldHighlightedRanges;
+  highlighting->m_viewportOnly = highlighting->m_waiting.size() > viewportHighlightingThreshold;
+  if (highlighting->m_viewportOnly) {
+    const QPair<int, int> visible = visibleWaitingRanges(tracker, highlighting);
+    highlighting->m_liveBegin = visible.first;
+    highlighting->m_liveEnd = visible.second;
+  } else {
+    highlighting->m_liveBegin = 0;
+    highlighting->m_liveEnd = highlighting->m_waiting.size();
+  }
+  highlighting->m_waitingPosition = highlighting->m_liveBegin;
+  highlighting->m_highlightedRanges.reserve(highlighting->m_liveEnd - highlighting->m_liveBegin);
   m_highlights[tracker] = highlighting;
 
-  // Now create MovingRanges (match old ones with the incoming ranges)
+  QElapsedTimer sliceTimer;
+  sliceTimer.start();
+  if (!applyHighlightingSlice(tracker, highlighting, sliceTimer))
+    scheduleApplyHighlighting();
+}
+
+void CodeHighlighting::applyPendingHighlightings()
+{
+  VERIFY_FOREGROUND_LOCKED
+  QMutexLocker lock(&m_dataMutex);
+  m_applyScheduled = false;
 
-  KTextEditor::Range tempRange;
+  QElapsedTimer sliceTimer;
+  sliceTimer.start();
 
-  QVector<MovingRange*>::iterator movingIt = oldHighlightedRanges.begin();
-  QVector<HighlightedRange>::iterator rangeIt = highlighting->m_waiting.begin();
+  for (auto it = m_highlights.constBegin(); it != m_highlights.constEnd(); ++it) {
+    if (it.value()->isApplied())
+      continue;
+    if (!applyHighlightingSlice(it.key(), it.value(), sliceTimer)) {
+      scheduleApplyHighlighting();
+      return;
+    }
+  }
+}
 
-  while(rangeIt != highlighting->m_waiting.end())
+void CodeHighlighting::scheduleApplyHighlighting()
+{
+  if (m_applyScheduled)
+    return;
+  m_applyScheduled = true;
+  // Return to the event loop before continuing, so the UI stays responsive
+  QTimer::singleShot(0, this, &CodeHighlighting::applyPendingHighlightings);
+}
+
+static bool sameAttribute(const KTextEditor::Attribute::Ptr& lhs, const KTextEditor::Attribute::Ptr& rhs)
+{
+  return lhs == rhs || (lhs && rhs && *lhs == *rhs);
+}
+
+static MovingRange* createMovingRange(DocumentChangeTracker* tracker, const KTextEditor::Range& range,
+                                      const KTextEditor::Attribute::Ptr& attribute)
+{
+  Q_ASSERT(attribute);
+  MovingRange* movingRange = tracker->documentMovingInterface()->newMovingRange(range);
+  movingRange->setAttribute(attribute);
+  movingRange->setZDepth(highlightingZDepth);
+  return movingRange;
+}
+
+bool CodeHighlighting::applyHighlightingSlice(DocumentChangeTracker* tracker, DocumentHighlighting* highlighting, const QElapsedTimer& sliceTimer)
+{
+  // Match the waiting ranges with the old moving ranges, and only create or destroy moving ranges where something changed
+
+  QVector<MovingRange*>& oldRanges = highlighting->m_oldRanges;
+  int& movingIt = highlighting->m_oldRangesPosition;
+  int& rangeIt = highlighting->m_waitingPosition;
+  int matched = 0;
+
+  while(rangeIt < highlighting->m_liveEnd)
   {
+    if (++matched % highlightingSliceGranularity == 0 && sliceTimer.elapsed() >= highlightingSliceTime)
+      return false;
+
+    const HighlightedRange& range = highlighting->m_waiting[rangeIt];
+
     // Translate the range into the current revision
-    KTextEditor::Range transformedRange = tracker->transformToCurrentRevision(rangeIt->range, highlighting->m_waitingRevision);
+    KTextEditor::Range transformedRange = highlighting->m_revision ? highlighting->m_revision->transformToCurrentRevision(range.range)
+                                                                   : range.range.castToSimpleRange();
 
-    while(movingIt != oldHighlightedRanges.end() &&
-      ((*movingIt)->start().line() < transformedRange.start().line() ||
-      ((*movingIt)->start().line() == transformedRange.start().line() && (*movingIt)->start().column() < transformedRange.start().column())))
+    while(movingIt < oldRanges.size() &&
+      (!oldRanges[movingIt] || oldRanges[movingIt]->start().toCursor() < transformedRange.start()))
     {
-      delete *movingIt; // Skip ranges that are in front of the current matched range
+      delete oldRanges[movingIt]; // Skip ranges that are in front of the current matched range
       ++movingIt;
     }
 
-
-    tempRange = transformedRange;
-
-    if(movingIt == oldHighlightedRanges.end() ||
-      transformedRange.start().line() != (*movingIt)->start().line() ||
-      transformedRange.start().column() != (*movingIt)->start().column() ||
-      transformedRange.end().line() != (*movingIt)->end().line() ||
-      transformedRange.end().column() != (*movingIt)->end().column())
+    if(movingIt == oldRanges.size() || oldRanges[movingIt]->toRange() != transformedRange)
     {
-      Q_ASSERT(rangeIt->attribute);
       // The moving range is behind or unequal, create a new range
-      highlighting->m_highlightedRanges.push_back(tracker->documentMovingInterface()->newMovingRange(tempRange));
-      highlighting->m_highlightedRanges.back()->setAttribute(rangeIt->attribute);
-      highlighting->m_highlightedRanges.back()->setZDepth(highlightingZDepth);
+      highlighting->m_highlightedRanges.push_back(createMovingRange(tracker, transformedRange, range.attribute));
     }
     else
     {
-      // Update the existing moving range
-      (*movingIt)->setAttribute(rangeIt->attribute);
-      (*movingIt)->setRange(tempRange);
-      highlighting->m_highlightedRanges.push_back(*movingIt);
+      // Reuse the existing moving range, and only touch it if its attribute changed
+      MovingRange* movingRange = oldRanges[movingIt];
+      if (!sameAttribute(movingRange->attribute(), range.attribute))
+        movingRange->setAttribute(range.attribute);
+      highlighting->m_highlightedRanges.push_back(movingRange);
       ++movingIt;
     }
     ++rangeIt;
   }
 
-  for(; movingIt != oldHighlightedRanges.end(); ++movingIt)
-    delete *movingIt; // Delete unmatched moving ranges behind
+  for(; movingIt < oldRanges.size(); ++movingIt)
+    delete oldRanges[movingIt]; // Delete unmatched moving ranges behind
+
+  // Everything is applied, release the intermediate state
+  oldRanges.clear();
+  movingIt = 0;
+  if (highlighting->m_viewportOnly) {
+    // The user may have scrolled while the slices were applied
+    m_viewportTimer->start();
+  } else {
+    highlighting->m_revision = RevisionReference();
+  }
+  return true;
+}
+
+QPair<int, int> CodeHighlighting::visibleWaitingRanges(DocumentChangeTracker* tracker, const DocumentHighlighting* highlighting) const
+{
+  int firstLine = -1;
+  int lastLine = -1;
+  foreach (View* view, tracker->document()->views()) {
+    if (!view->isVisible())
+      continue;
+    const KTextEditor::Range lines = KTextEditorHelpers::visibleLines(view);
+    const int first = lines.start().line();
+    const int last = lines.end().line();
+    firstLine = firstLine == -1 ? first : qMin(firstLine, first);
+    lastLine = qMax(lastLine, last);
+  }
+
+  if (firstLine == -1) {
+    // Nothing is visible, prepare the beginning of the document
+    firstLine = 0;
+    lastLine = 0;
+  }
+
+  KTextEditor::Range visible(qMax(0, firstLine - viewportMarginLines), 0, lastLine + viewportMarginLines + 1, 0);
+  RangeInRevision visibleInRevision = highlighting->m_revision ? highlighting->m_revision->transformFromCurrentRevision(visible)
+                                                               : RangeInRevision::castFromSimpleRange(visible);
+
+  auto lineLessThan = [](const HighlightedRange& range, int line) {
+    return range.range.start.line < line;
+  };
+  const auto begin = std::lower_bound(highlighting->m_waiting.constBegin(), highlighting->m_waiting.constEnd(),
+                                      visibleInRevision.start.line, lineLessThan);
+  const auto end = std::lower_bound(begin, highlighting->m_waiting.constEnd(),
+                                    visibleInRevision.end.line, lineLessThan);
+  return qMakePair(int(begin - highlighting->m_waiting.constBegin()), int(end - highlighting->m_waiting.constBegin()));
+}
+
+void CodeHighlighting::moveLiveWindow(DocumentChangeTracker* tracker, DocumentHighlighting* highlighting)
+{
+  const QPair<int, int> visible = visibleWaitingRanges(tracker, highlighting);
+  const int oldBegin = highlighting->m_liveBegin;
+  const int oldEnd = highlighting->m_liveEnd;
+  if (visible.first == oldBegin && visible.second == oldEnd)
+    return;
+
+  QVector<MovingRange*> ranges;
+  ranges.reserve(visible.second - visible.first);
+  for (int i = visible.first; i < visible.second; ++i) {
+    if (i >= oldBegin && i < oldEnd) {
+      ranges.push_back(highlighting->m_highlightedRanges[i - oldBegin]);
+    } else {
+      const HighlightedRange& range = highlighting->m_waiting[i];
+      ranges.push_back(createMovingRange(tracker, highlighting->m_revision->transformToCurrentRevision(range.range),
+                                         range.attribute));
+    }
+  }
+  for (int i = oldBegin; i < oldEnd; ++i) {
+    if (i < visible.first || i >= visible.second)
+      delete highlighting->m_highlightedRanges[i - oldBegin];
+  }
+
+  highlighting->m_highlightedRanges = ranges;
+  highlighting->m_liveBegin = visible.first;
+  highlighting->m_liveEnd = visible.second;
+  highlighting->m_waitingPosition = visible.second;
+}
+
+void CodeHighlighting::viewCreated(Document*, View* view)
+{
+  connect(view, &View::verticalScrollPositionChanged, m_viewportTimer, static_cast<void (QTimer::*)()>(&QTimer::start),
+          Qt::UniqueConnection);
+}
+
+void CodeHighlighting::updateViewports()
+{
+  VERIFY_FOREGROUND_LOCKED
+  QMutexLocker lock(&m_dataMutex);
+  for (auto it = m_highlights.constBegin(); it != m_highlights.constEnd(); ++it) {
+    DocumentHighlighting* highlighting = it.value();
+    // Partially applied highlightings check the viewport again when they are done
+    if (highlighting->m_viewportOnly && highlighting->m_revision && highlighting->isApplied())
+      moveLiveWindow(it.key(), highlighting);
+  }
 }
 
 void CodeHighlighting::trackerDestroyed(QObject* object)
@@ -623,14 +805,20 @@ void CodeHighlighting::aboutToRemoveText( const KTextEditor::Range& range )
                                       ->trackerForUrl(IndexedString(doc->url()));
   if(m_highlights.contains(tracker))
   {
-    QVector<MovingRange*>& ranges = m_highlights.value(tracker)->m_highlightedRanges;
-    QVector<MovingRange*>::iterator it = ranges.begin();
-    while(it != ranges.end()) {
-      if (range.contains((*it)->toRange())) {
-        delete (*it);
-        it = ranges.erase(it);
-      } else {
-        ++it;
+    DocumentHighlighting* highlighting = m_highlights.value(tracker);
+    // The ranges are only cleared, so they keep matching their waiting ranges and the slice position stays valid
+    QVector<MovingRange*>& ranges = highlighting->m_highlightedRanges;
+    for (int i = 0; i < ranges.size(); ++i) {
+      if (ranges[i] && range.contains(ranges[i]->toRange())) {
+        delete ranges[i];
+        ranges[i] = nullptr;
+      }
+    }
+    QVector<MovingRange*>& oldRanges = highlighting->m_oldRanges;
+    for (int i = highlighting->m_oldRangesPosition; i < oldRanges.size(); ++i) {
+      if (oldRanges[i] && range.contains(oldRanges[i]->toRange())) {
+        delete oldRanges[i];
+        oldRanges[i] = nullptr;
       }
     }
   }
@@ -27,6 +27,13 @@
 #include <QObject>
 #include <QHash>
 
+class QElapsedTimer;
+class QTimer;
+
+namespace KTextEditor {
+class View;
+}
+
 #include <ktexteditor/attribute.h>
 #include <ktexteditor/movingrange.h>
 
@@ -181,11 +188,42 @@ class KDEVPLATFORMLANGUAGE_EXPORT CodeHighlighting : public QObject, public KDev
       qint64 m_waitingRevision;
       // The ranges are sorted by range start, so they can easily be matched
       QVector<HighlightedRange> m_waiting;
+      // m_highlightedRanges[i] is the moving range for m_waiting[m_liveBegin + i],
+      // or zero if the text it covered was removed
       QVector<KTextEditor::MovingRange*> m_highlightedRanges;
+
+      // Only m_waiting[m_liveBegin...m_liveEnd) get moving ranges. This is the whole document,
+      // unless the document is so big that only the visible region is highlighted.
+      int m_liveBegin = 0;
+      int m_liveEnd = 0;
+      bool m_viewportOnly = false;
+
+      // The waiting ranges are applied in time slices. m_waiting[m_waitingPosition...m_liveEnd) still has to be
+      // matched against m_oldRanges[m_oldRangesPosition...], the not yet consumed ranges of the previous highlighting.
+      RevisionReference m_revision;
+      QVector<KTextEditor::MovingRange*> m_oldRanges;
+      int m_waitingPosition = 0;
+      int m_oldRangesPosition = 0;
+
+      bool isApplied() const {
+        return m_waitingPosition >= m_liveEnd;
+      }
     };
 
-    QMap<DocumentChangeTracker*, DocumentHighlighting*> m_highlights;
+    /// Matches the next waiting ranges of @p highlighting against the existing moving ranges,
+    /// until either everything is applied or the time slice is used up.
+    /// @return whether the highlighting was applied completely
+    bool applyHighlightingSlice(DocumentChangeTracker* tracker, DocumentHighlighting* highlighting, const QElapsedTimer& sliceTimer);
+    void scheduleApplyHighlighting();
+
+    /// @return the range of waiting indices that are visible in a view of the document, plus a margin
+    QPair<int, int> visibleWaitingRanges(DocumentChangeTracker* tracker, const DocumentHighlighting* highlighting) const;
+    /// Creates moving ranges for what became visible, and deletes the ones that went far out of sight
+    void moveLiveWindow(DocumentChangeTracker* tracker, DocumentHighlighting* highlighting);
 
+    QMap<DocumentChangeTracker*, DocumentHighlighting*> m_highlights;
+    bool m_applyScheduled;
+    QTimer* m_viewportTimer;
 
     friend class CodeHighlightingInstance;
 
@@ -203,6 +241,7 @@ class KDEVPLATFORMLANGUAGE_EXPORT CodeHighlighting : public QObject, public KDev
   private Q_SLOTS:
     void clearHighlightingForDocument(KDevelop::IndexedString document);
     void applyHighlighting(void* highlighting);
+    void applyPendingHighlightings();
 
     void trackerDestroyed(QObject* object);
 
@@ -211,6 +250,9 @@ class KDEVPLATFORMLANGUAGE_EXPORT CodeHighlighting : public QObject, public KDev
 
     void aboutToInvalidateMovingInterfaceContent(KTextEditor::Document*);
     void aboutToRemoveText(const KTextEditor::Range&);
+
+    void viewCreated(KTextEditor::Document*, KTextEditor::View* view);
+    void updateViewports();
 };
 
 }
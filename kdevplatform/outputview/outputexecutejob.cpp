@@ -28,6 +28,8 @@ Boston, MA 02110-1301, USA.
 #include <util/processlinemaker.h>
 #include <KProcess>
 #include <KLocalizedString>
+#include <KConfigGroup>
+#include <KSharedConfig>
 #include <KShell>
 #include <QFileInfo>
 #include <QDir>
@@ -230,6 +232,10 @@ void OutputExecuteJob::start()
     }
     Q_ASSERT( model() );
 
+    // long running processes must not grow the output without bounds, 0 disables the limit
+    const KConfigGroup outputConfig = KSharedConfig::openConfig()->group("Output View");
+    model()->setMaxLines(outputConfig.readEntry("MaxLines", 1000000));
+
     if (d->m_filteringStrategyPtr) {
         model()->setFilteringStrategy(d->m_filteringStrategyPtr.take());
     } else {
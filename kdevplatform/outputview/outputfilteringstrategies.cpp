@@ -58,6 +58,67 @@ FilteredItem match(const ErrorFormats& errorFormats, const QString& line)
     return item;
 }
 
+namespace {
+
+bool isDigit(QChar c)
+{
+    return c.unicode() >= '0' && c.unicode() <= '9';
+}
+
+bool containsAny(const QString& line, std::initializer_list<QLatin1String> literals)
+{
+    return std::any_of(literals.begin(), literals.end(), [&line](QLatin1String literal) {
+        return line.contains(literal);
+    });
+}
+
+/**
+ * Cheap check whether @p line could match any of the compiler error formats.
+ *
+ * Every expression in CompilerFilterStrategy::errorInLine requires at least one of
+ * these anchors, so lines without them can skip the regular expressions entirely.
+ * Keep this in sync when adding new formats.
+ */
+bool mayContainCompilerError(const QString& line)
+{
+    const int size = line.size();
+    for (int i = line.indexOf(QLatin1Char(':')); i != -1; i = line.indexOf(QLatin1Char(':'), i + 1)) {
+        // "file:12", "line 12:", "file(12):"
+        if ((i + 1 < size && isDigit(line.at(i + 1)))
+            || (i > 0 && (isDigit(line.at(i - 1)) || line.at(i - 1) == QLatin1Char(')'))))
+        {
+            return true;
+        }
+    }
+
+    return containsAny(line, {QLatin1String("libtool: link: warning: "), QLatin1String("No rule to make target"),
+                              QLatin1String("CMake "), QLatin1String(": error: "), QLatin1String("automoc4: "),
+                              QLatin1String("fortcom: "), QLatin1String("PGF9")});
+}
+
+/**
+ * Cheap check whether @p line could match any of the compiler action formats.
+ *
+ * Same contract as mayContainCompilerError, for CompilerFilterStrategy::actionInLine.
+ */
+bool mayContainCompilerAction(const QString& line)
+{
+    const int size = line.size();
+    for (int i = line.indexOf(QLatin1Char('-')); i != -1 && i + 1 < size; i = line.indexOf(QLatin1Char('-'), i + 1)) {
+        // "-c", "-o", "--mode=", "-- Configuring"
+        const QChar next = line.at(i + 1);
+        if (next == QLatin1Char('c') || next == QLatin1Char('o') || next == QLatin1Char('-')) {
+            return true;
+        }
+    }
+
+    return containsAny(line, {QLatin1String("%] "), QLatin1String("Entering directory"), QLatin1String("ompiling "),
+                              QLatin1String("enerating "), QLatin1String("inking "), QLatin1String("mkinstalldirs"),
+                              QLatin1String("/usr/bin/install"), QLatin1String("dcopidl")});
+}
+
+}
+
 /// --- No filter strategy ---
 
 NoFilterStrategy::NoFilterStrategy()
@@ -201,6 +262,10 @@ FilteredItem CompilerFilterStrategy::actionInLine(const QString& line)
     };
 
     FilteredItem item(line);
+    if (!mayContainCompilerAction(line)) {
+        return item;
+    }
+
     for (const auto& curActFilter : ACTION_FILTERS) {
         const auto match = curActFilter.expression.match(line);
         if( match.hasMatch() ) {
@@ -298,6 +363,10 @@ FilteredItem CompilerFilterStrategy::errorInLine(const QString& line)
     };
 
     FilteredItem item(line);
+    if (!mayContainCompilerError(line)) {
+        return item;
+    }
+
     for (const auto& curErrFilter : ERROR_FILTERS) {
         const auto match = curErrFilter.expression.match(line);
         if( match.hasMatch() && !( line.contains( QLatin1String("Each undeclared identifier is reported only once") )
@@ -193,6 +193,7 @@ public:
     // We use std::set because that is ordered
     std::set<int> m_errorItems; // Indices of all items that we want to move to using previous and next
     QUrl m_buildDir;
+    int m_maxLines = 0;
 
     void linesParsed(const QVector<KDevelop::FilteredItem>& items)
     {
@@ -206,9 +207,58 @@ public:
         }
 
         model->endInsertRows();
+
+        trimToMaxLines();
     }
+
+    void trimToMaxLines();
 };
 
+void OutputModelPrivate::trimToMaxLines()
+{
+    if (m_maxLines <= 0 || m_filteredItems.size() <= m_maxLines) {
+        return;
+    }
+
+    // drop a whole block at once, so that we don't need to shift the items for every new batch
+    const int keepCount = m_maxLines - m_maxLines / 10;
+    const int maxRetained = m_maxLines / 2;
+
+    // the errors and warnings kept from the dropped block count against the lines we keep,
+    // otherwise the model would stay above the limit and get trimmed again for every batch
+    QVector<FilteredItem> retained;
+    int removeCount = 0;
+    while (removeCount < m_filteredItems.size()
+           && m_filteredItems.size() - removeCount + qMin(retained.size(), maxRetained) > keepCount) {
+        const FilteredItem& item = m_filteredItems.at(removeCount++);
+        if (item.type == FilteredItem::ErrorItem || item.type == FilteredItem::WarningItem) {
+            retained << item;
+        }
+    }
+    if (retained.size() > maxRetained) {
+        retained.remove(0, retained.size() - maxRetained);
+    }
+
+    model->beginRemoveRows(QModelIndex(), 0, removeCount - 1);
+    m_filteredItems.remove(0, removeCount);
+    model->endRemoveRows();
+
+    if (!retained.isEmpty()) {
+        const int retainedCount = retained.size();
+        model->beginInsertRows(QModelIndex(), 0, retainedCount - 1);
+        retained += m_filteredItems;
+        m_filteredItems.swap(retained);
+        model->endInsertRows();
+    }
+
+    m_errorItems.clear();
+    for (int i = 0; i < m_filteredItems.size(); ++i) {
+        if (m_filteredItems.at(i).type == FilteredItem::ErrorItem) {
+            m_errorItems.insert(m_errorItems.end(), i);
+        }
+    }
+}
+
 OutputModelPrivate::OutputModelPrivate( OutputModel* model_, const QUrl& builddir)
 : model(model_)
 , worker(new ParseWorker )
@@ -440,6 +490,17 @@ void OutputModel::setFilteringStrategy(IFilterStrategy* filterStrategy)
                               Q_ARG(KDevelop::IFilterStrategy*, filterStrategy));
 }
 
+void OutputModel::setMaxLines(int maxLines)
+{
+    d->m_maxLines = qMax(0, maxLines);
+    d->trimToMaxLines();
+}
+
+int OutputModel::maxLines() const
+{
+    return d->m_maxLines;
+}
+
 void OutputModel::appendLines( const QStringList& lines )
 {
     if( lines.isEmpty() )
@@ -464,6 +525,7 @@ void OutputModel::clear()
     ensureAllDone();
     beginResetModel();
     d->m_filteredItems.clear();
+    d->m_errorItems.clear();
     endResetModel();
 }
 
@@ -70,6 +70,19 @@ public:
     void setFilteringStrategy(const OutputFilterStrategy& currentStrategy);
     void setFilteringStrategy(IFilterStrategy* filterStrategy);
 
+    /**
+     * Limit the number of lines kept in the model to roughly @p maxLines.
+     *
+     * When the limit is exceeded, the oldest lines are dropped in blocks of
+     * a tenth of the limit. Errors and warnings from the dropped blocks are
+     * kept at the top of the model, as long as they use at most half of the limit.
+     * They count towards the limit, so more lines get dropped instead.
+     *
+     * A value of 0, the default, keeps all lines.
+     */
+    void setMaxLines(int maxLines);
+    int maxLines() const;
+
 public Q_SLOTS:
     void appendLine( const QString& );
     void appendLines( const QStringList& );
@@ -136,6 +136,10 @@ void TestFilteringStrategy::testCompilerFilterStrategy_data()
     << "automoc4: The file \"/foo/bar.cpp\" includes the moc file \"bar1.moc\"" << FilteredItem::InformationItem << FilteredItem::InvalidItem << UnixFilePathNoSpaces;
     QTest::newRow("cmake-autogen-error")
     << "AUTOGEN: error: /foo/bar.cpp The file includes the moc file \"moc_bar1.cpp\"" << FilteredItem::ErrorItem << FilteredItem::InvalidItem << UnixFilePathNoSpaces;
+    QTest::newRow("plain-output-line")
+    << "Scanning dependencies of target kdevplatformutil" << FilteredItem::InvalidItem << FilteredItem::InvalidItem << UnixFilePathNoSpaces;
+    QTest::newRow("plain-output-line-with-colon")
+    << "Note: some input files use unchecked or unsafe operations." << FilteredItem::InvalidItem << FilteredItem::InvalidItem << UnixFilePathNoSpaces;
     QTest::newRow("linker-action-line")
     << "linking testCustombuild (g++)" << FilteredItem::InvalidItem << FilteredItem::ActionItem << UnixFilePathNoSpaces;
     for (TestPathType pathType : {UnixFilePathNoSpaces, UnixFilePathWithSpaces}) {
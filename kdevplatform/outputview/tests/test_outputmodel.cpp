@@ -20,6 +20,7 @@
 #include "testlinebuilderfunctions.h"
 #include "../outputmodel.h"
 
+#include <QSignalSpy>
 #include <QTest>
 
 QTEST_MAIN(KDevelop::TestOutputModel)
@@ -116,4 +117,62 @@ void TestOutputModel::bench_data()
     QTest::newRow("static-analysis-filter-longline") << OutputModel::StaticAnalysisFilter << longLine;
 }
 
+void TestOutputModel::testMaxLines()
+{
+    OutputModel testee(QUrl::fromLocalFile(QStringLiteral("/tmp/build-foo")));
+    testee.setFilteringStrategy(OutputModel::CompilerFilter);
+    testee.setMaxLines(100);
+
+    QStringList lines;
+    lines << buildCompilerErrorLine();
+    for (int i = 0; i < 1000; ++i) {
+        lines << QStringLiteral("line %1").arg(i);
+    }
+
+    QSignalSpy spy(&testee, &OutputModel::allDone);
+    testee.appendLines(lines);
+    testee.ensureAllDone();
+    QVERIFY(spy.wait());
+
+    QVERIFY(testee.rowCount() <= 100);
+    // the newest lines are kept
+    QCOMPARE(testee.data(testee.index(testee.rowCount() - 1)).toString(), lines.last());
+    // and so is the error from the beginning of the output
+    QCOMPARE(testee.data(testee.index(0)).toString(), lines.first());
+    QCOMPARE(testee.firstHighlightIndex(), testee.index(0));
+}
+
+
+void TestOutputModel::testMaxLinesWithManyErrors()
+{
+    OutputModel testee(QUrl::fromLocalFile(QStringLiteral("/tmp/build-foo")));
+    testee.setFilteringStrategy(OutputModel::CompilerFilter);
+    testee.setMaxLines(1000);
+
+    // more errors than fit into the tenth of the limit that gets dropped at once
+    QStringList lines;
+    for (int i = 0; i < 3000; ++i) {
+        lines << ((i % 10) ? QStringLiteral("line %1").arg(i) : buildCompilerErrorLine());
+    }
+
+    QSignalSpy spy(&testee, &OutputModel::allDone);
+    testee.appendLines(lines);
+    testee.ensureAllDone();
+    QVERIFY(spy.wait());
+    QVERIFY(testee.rowCount() <= 1000);
+    QCOMPARE(testee.data(testee.index(testee.rowCount() - 1)).toString(), lines.last());
+
+    // as long as the limit is not exceeded, nothing gets trimmed
+    QSignalSpy removedSpy(&testee, &OutputModel::rowsRemoved);
+    QStringList moreLines;
+    for (int i = testee.rowCount(); i < 1000; ++i) {
+        moreLines << QStringLiteral("more %1").arg(i);
+    }
+    testee.appendLines(moreLines);
+    testee.ensureAllDone();
+    QVERIFY(spy.wait());
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(testee.rowCount(), 1000);
+}
+
 }
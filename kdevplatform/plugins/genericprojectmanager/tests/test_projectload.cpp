@@ -24,6 +24,7 @@
 #include <QProcess>
 #include <QTemporaryDir>
 #include <QDebug>
+#include <QStandardPaths>
 
 #include <tests/autotestshell.h>
 #include <tests/testcore.h>
@@ -58,6 +59,8 @@ void exec(const QString &cmd)
 
 void TestProjectLoad::initTestCase()
 {
+    // the project snapshots are saved below the cache location
+    QStandardPaths::setTestModeEnabled(true);
     AutoTestShell::init({QStringLiteral("KDevGenericManager")});
     TestCore::initialize();
     ICore::self()->languageController()->backgroundParser()->disableProcessing();
@@ -408,3 +411,65 @@ void TestProjectLoad::addDuringImport()
     //      esp. when adding a file at a point where the parent folder was already imported
     //      or removing a file that was already imported
 }
+
+void TestProjectLoad::reopenChangedProject()
+{
+    const TestProject p = makeProject();
+    QVERIFY(createFile(p.dir->path() + "/removed"));
+    QVERIFY(QDir(p.dir->path()).mkdir(QStringLiteral("sub")));
+    QVERIFY(createFile(p.dir->path() + "/sub/kept"));
+
+    QSignalSpy spy(ICore::self()->projectController(), SIGNAL(projectOpened(KDevelop::IProject*)));
+    ICore::self()->projectController()->openProject(p.file);
+    QVERIFY(spy.wait(2000));
+    IProject* project = ICore::self()->projectController()->projects().first();
+    QCOMPARE(project->fileSet().size(), 2);
+
+    // saves the snapshot which the next import starts from
+    ICore::self()->projectController()->closeProject(project);
+    QTest::qWait(100);
+
+    QVERIFY(QFile::remove(p.dir->path() + "/removed"));
+    QVERIFY(createFile(p.dir->path() + "/sub/added"));
+
+    ICore::self()->projectController()->openProject(p.file);
+    QVERIFY(spy.wait(2000));
+    project = ICore::self()->projectController()->projects().first();
+
+    // the restored folders are verified after the import, changed ones get reloaded
+    auto hasFile = [project](const QString& path) {
+        return !project->filesForPath(IndexedString(QUrl::fromLocalFile(path))).isEmpty();
+    };
+    QTRY_VERIFY(hasFile(p.dir->path() + "/sub/added"));
+    QTRY_VERIFY(!hasFile(p.dir->path() + "/removed"));
+    QVERIFY(hasFile(p.dir->path() + "/sub/kept"));
+}
+
+void TestProjectLoad::watchNewFolders()
+{
+    const TestProject p = makeProject();
+
+    QSignalSpy spy(ICore::self()->projectController(), SIGNAL(projectOpened(KDevelop::IProject*)));
+    ICore::self()->projectController()->openProject(p.file);
+    QVERIFY(spy.wait(2000));
+    IProject* project = ICore::self()->projectController()->projects().first();
+    QCOMPARE(project->fileSet().size(), 0);
+
+    auto hasFile = [project](const QString& path) {
+        return !project->filesForPath(IndexedString(QUrl::fromLocalFile(path))).isEmpty();
+    };
+
+    // a burst of changes gets applied in one go
+    QVERIFY(QDir(p.dir->path()).mkpath(QStringLiteral("new/nested")));
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(createFile(QString(p.dir->path() + "/new/nested/%1").arg(i)));
+    }
+    QTRY_COMPARE(project->fileSet().size(), 10);
+
+    // the folders added to the project tree are watched, too
+    QVERIFY(createFile(p.dir->path() + "/new/nested/added"));
+    QTRY_VERIFY(hasFile(p.dir->path() + "/new/nested/added"));
+    QVERIFY(QFile::remove(p.dir->path() + "/new/nested/0"));
+    QTRY_VERIFY(!hasFile(p.dir->path() + "/new/nested/0"));
+    QCOMPARE(project->fileSet().size(), 10);
+}
@@ -44,6 +44,9 @@ private Q_SLOTS:
   void raceJob();
 
   void addDuringImport();
+
+  void reopenChangedProject();
+  void watchNewFolders();
 };
 
 #endif
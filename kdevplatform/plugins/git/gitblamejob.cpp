@@ -0,0 +1,109 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "gitblamejob.h"
+
+#include <vcs/vcsrevision.h>
+
+#include <QDateTime>
+
+using namespace KDevelop;
+
+GitBlameJob::GitBlameJob(const QDir& workingDir, KDevelop::IPlugin* parent, KDevelop::OutputJob::OutputJobVerbosity verbosity)
+    : GitJob(workingDir, parent, verbosity)
+{
+    setType(VcsJob::Annotate);
+    connect(this, &GitBlameJob::receivedStdout, this, &GitBlameJob::parseOutput);
+    connect(this, &GitBlameJob::readyForParsing, this, &GitBlameJob::parseRemainder);
+}
+
+QVariant GitBlameJob::fetchResults()
+{
+    QVariantList results;
+    results.swap(m_pendingResults);
+    return results;
+}
+
+void GitBlameJob::parseOutput(const QByteArray& output)
+{
+    m_buffer.append(output);
+
+    const int resultCount = m_pendingResults.size();
+    QByteArray line;
+    while (m_buffer.takeLine(&line)) {
+        parseLine(line);
+    }
+
+    if (m_pendingResults.size() != resultCount) {
+        emit resultsReady(this);
+    }
+}
+
+void GitBlameJob::parseRemainder()
+{
+    // the output should end with a newline, but don't lose the last line if it doesn't
+    if (!m_buffer.isEmpty()) {
+        parseLine(m_buffer.takeAll());
+    }
+}
+
+void GitBlameJob::parseLine(const QByteArray& line)
+{
+    if (line.startsWith('\t')) {
+        // the content of the annotated line ends its block
+        VcsAnnotationLine annotation = m_commits.value(m_currentCommit);
+        annotation.setLineNumber(m_currentLine);
+        m_pendingResults += qVariantFromValue(annotation);
+        m_expectHeader = true;
+        return;
+    }
+
+    if (line.isEmpty())
+        return;
+
+    const int nameEnd = line.indexOf(' ');
+    const QByteArray name = line.left(nameEnd);
+    const QByteArray value = nameEnd < 0 ? QByteArray() : line.mid(nameEnd + 1);
+
+    if (m_expectHeader) {
+        // "<sha1> <original line> <final line> [<lines in group>]"
+        m_expectHeader = false;
+        m_currentCommit = name;
+        m_currentLine = value.split(' ').value(1).toInt() - 1;
+
+        auto it = m_commits.find(name);
+        if (it == m_commits.end()) {
+            VcsRevision rev;
+            rev.setRevisionValue(QString::fromLatin1(name.left(8)), KDevelop::VcsRevision::GlobalNumber);
+            VcsAnnotationLine annotation;
+            annotation.setRevision(rev);
+            m_commits.insert(name, annotation);
+        }
+        return;
+    }
+
+    // the metadata of a commit is only given the first time the commit shows up
+    if (name == "author")
+        m_commits[m_currentCommit].setAuthor(QString::fromUtf8(value));
+    else if (name == "author-time")
+        m_commits[m_currentCommit].setDate(QDateTime::fromTime_t(value.toUInt()));
+    else if (name == "summary")
+        m_commits[m_currentCommit].setCommitMessage(QString::fromUtf8(value));
+    // everything else (e-mail, committer, previous, filename, boundary) isn't needed
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
+#define KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
+
+#include "gitjob.h"
+
+#include <vcs/vcsannotation.h>
+#include <util/linebuffer.h>
+
+#include <QHash>
+
+/**
+ * Runs git blame and parses its porcelain output while it arrives.
+ *
+ * Annotation lines are reported with resultsReady() whenever a chunk of output
+ * has been parsed, and fetchResults() only returns the lines not fetched before.
+ * Commit metadata is only parsed once per commit and shared by all its lines.
+ */
+class GitBlameJob : public GitJob
+{
+    Q_OBJECT
+    public:
+        explicit GitBlameJob(const QDir& workingDir, KDevelop::IPlugin* parent = nullptr, KDevelop::OutputJob::OutputJobVerbosity verbosity = KDevelop::OutputJob::Silent);
+
+        QVariant fetchResults() override;
+
+    private:
+        void parseOutput(const QByteArray& output);
+        void parseLine(const QByteArray& line);
+        void parseRemainder();
+
+        KDevelop::LineBuffer m_buffer;
+        QHash<QByteArray, KDevelop::VcsAnnotationLine> m_commits;
+        QByteArray m_currentCommit;
+        int m_currentLine = -1;
+        /// True if the next line starts a new annotated line, i.e. is a commit header
+        bool m_expectHeader = true;
+        QVariantList m_pendingResults;
+};
+
+#endif // KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
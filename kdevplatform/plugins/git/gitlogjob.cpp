@@ -0,0 +1,139 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "gitlogjob.h"
+
+#include <vcs/vcsrevision.h>
+
+#include <QDateTime>
+
+using namespace KDevelop;
+
+namespace {
+
+VcsItemEvent::Actions actionsFromString(char c)
+{
+    switch(c) {
+        case 'A': return VcsItemEvent::Added;
+        case 'D': return VcsItemEvent::Deleted;
+        case 'R': return VcsItemEvent::Replaced;
+        case 'M': return VcsItemEvent::Modified;
+    }
+    return VcsItemEvent::Modified;
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+}
+
+GitLogJob::GitLogJob(const QDir& workingDir, KDevelop::IPlugin* parent, KDevelop::OutputJob::OutputJobVerbosity verbosity)
+    : GitJob(workingDir, parent, verbosity)
+{
+    setType(VcsJob::Log);
+    connect(this, &GitLogJob::receivedStdout, this, &GitLogJob::parseOutput);
+    connect(this, &GitLogJob::readyForParsing, this, &GitLogJob::parseRemainder);
+}
+
+QVariant GitLogJob::fetchResults()
+{
+    QVariantList results;
+    results.swap(m_pendingResults);
+    return results;
+}
+
+void GitLogJob::parseOutput(const QByteArray& output)
+{
+    m_buffer.append(output);
+
+    const int resultCount = m_pendingResults.size();
+    QByteArray line;
+    while (m_buffer.takeLine(&line)) {
+        parseLine(line);
+    }
+
+    if (m_pendingResults.size() != resultCount) {
+        emit resultsReady(this);
+    }
+}
+
+void GitLogJob::parseRemainder()
+{
+    if (!m_buffer.isEmpty()) {
+        parseLine(m_buffer.takeAll());
+    }
+    // the last commit is only complete once the output ended
+    finishEvent();
+}
+
+void GitLogJob::finishEvent()
+{
+    if (!m_hasEvent)
+        return;
+
+    m_event.setMessage(m_message.trimmed());
+    m_pendingResults += QVariant::fromValue(m_event);
+
+    m_event.setItems(QList<VcsItemEvent>());
+    m_message.clear();
+    m_hasEvent = false;
+}
+
+void GitLogJob::parseLine(const QByteArray& line)
+{
+    if (line.startsWith("    ")) {
+        m_message += QString::fromLocal8Bit(line.constData() + 4, line.size() - 4);
+        m_message += QLatin1Char('\n');
+    } else if (line.startsWith("commit ")) {
+        // "commit <sha1>"
+        finishEvent();
+        VcsRevision rev;
+        rev.setRevisionValue(QString::fromLatin1(line.mid(7, 8)), KDevelop::VcsRevision::GlobalNumber);
+        m_event.setRevision(rev);
+        m_hasEvent = true;
+    } else if (line.startsWith("Author:")) {
+        m_event.setAuthor(QString::fromLocal8Bit(line.mid(7)).trimmed());
+    } else if (line.startsWith("Date:")) {
+        // --date=raw gives "<seconds since epoch> <timezone>"
+        m_event.setDate(QDateTime::fromTime_t(line.mid(5).trimmed().split(' ').value(0).toUInt()));
+    } else if (!line.isEmpty() && line[0] >= 'A' && line[0] <= 'Z') {
+        // "<status>[<score>]\t<path>[\t<other path>]", e.g.
+        //R099    plugins/git/kdevgit.desktop     plugins/git/kdevgit.desktop.cmake
+        //M       plugins/grepview/CMakeLists.txt
+        int pos = 1;
+        while (pos < line.size() && isDigit(line[pos]))
+            ++pos;
+        if (pos == line.size() || line[pos] != '\t')
+            return;
+
+        const int pathStart = pos + 1;
+        const int pathEnd = line.indexOf('\t', pathStart);
+
+        VcsItemEvent itemEvent;
+        const VcsItemEvent::Actions a = actionsFromString(line[0]);
+        itemEvent.setActions(a);
+        itemEvent.setRepositoryLocation(QString::fromLocal8Bit(line.mid(pathStart, pathEnd < 0 ? -1 : pathEnd - pathStart)));
+        if (a == VcsItemEvent::Replaced && pathEnd >= 0) {
+            itemEvent.setRepositoryCopySourceLocation(QString::fromLocal8Bit(line.mid(pathEnd + 1)));
+        }
+        m_event.addItem(itemEvent);
+    }
+}
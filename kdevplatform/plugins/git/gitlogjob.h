@@ -0,0 +1,57 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PLUGIN_GITLOGJOB_H
+#define KDEVPLATFORM_PLUGIN_GITLOGJOB_H
+
+#include "gitjob.h"
+
+#include <vcs/vcsevent.h>
+#include <util/linebuffer.h>
+
+/**
+ * Runs git log --name-status and parses its output while it arrives.
+ *
+ * Every commit is reported with resultsReady() as soon as the next one starts,
+ * and fetchResults() only returns the events not fetched before, so a history
+ * view can show the first commits while git is still walking the history.
+ */
+class GitLogJob : public GitJob
+{
+    Q_OBJECT
+    public:
+        explicit GitLogJob(const QDir& workingDir, KDevelop::IPlugin* parent = nullptr, KDevelop::OutputJob::OutputJobVerbosity verbosity = KDevelop::OutputJob::Silent);
+
+        QVariant fetchResults() override;
+
+    private:
+        void parseOutput(const QByteArray& output);
+        void parseLine(const QByteArray& line);
+        void parseRemainder();
+        void finishEvent();
+
+        KDevelop::LineBuffer m_buffer;
+        KDevelop::VcsEvent m_event;
+        QString m_message;
+        /// True if m_event has been started by a commit line
+        bool m_hasEvent = false;
+        QVariantList m_pendingResults;
+};
+
+#endif // KDEVPLATFORM_PLUGIN_GITLOGJOB_H
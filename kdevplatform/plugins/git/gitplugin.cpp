@@ -30,6 +30,7 @@
 #include <QTimer>
 #include <QRegularExpression>
 #include <QPointer>
+#include <QSet>
 
 #include <interfaces/icore.h>
 #include <interfaces/iproject.h>
@@ -55,6 +56,8 @@
 #include <KTextEditor/Document>
 
 #include "gitjob.h"
+#include "gitblamejob.h"
+#include "gitlogjob.h"
 #include "gitmessagehighlighter.h"
 #include "gitplugincheckinrepositoryjob.h"
 #include "gitnameemaildialog.h"
@@ -590,22 +593,19 @@ VcsJob* GitPlugin::remove(const QList<QUrl>& files)
 VcsJob* GitPlugin::log(const QUrl& localLocation,
                 const KDevelop::VcsRevision& src, const KDevelop::VcsRevision& dst)
 {
-    DVcsJob* job = new GitJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
-    job->setType(VcsJob::Log);
+    DVcsJob* job = new GitLogJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
     *job << "git" << "log" << "--date=raw" << "--name-status" << "-M80%" << "--follow";
     QString rev = revisionInterval(dst, src);
     if(!rev.isEmpty())
         *job << rev;
     *job << "--" << localLocation;
-    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitLogOutput);
     return job;
 }
 
 
 VcsJob* GitPlugin::log(const QUrl& localLocation, const KDevelop::VcsRevision& rev, unsigned long int limit)
 {
-    DVcsJob* job = new GitJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
-    job->setType(VcsJob::Log);
+    DVcsJob* job = new GitLogJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
     *job << "git" << "log" << "--date=raw" << "--name-status" << "-M80%" << "--follow";
     QString revStr = toRevisionName(rev, QString());
     if(!revStr.isEmpty())
@@ -614,79 +614,17 @@ VcsJob* GitPlugin::log(const QUrl& localLocation, const KDevelop::VcsRevision& r
         *job << QStringLiteral("-%1").arg(limit);
 
     *job << "--" << localLocation;
-    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitLogOutput);
     return job;
 }
 
 KDevelop::VcsJob* GitPlugin::annotate(const QUrl &localLocation, const KDevelop::VcsRevision&)
 {
-    DVcsJob* job = new GitJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
-    job->setType(VcsJob::Annotate);
+    DVcsJob* job = new GitBlameJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
     *job << "git" << "blame" << "--porcelain" << "-w";
     *job << "--" << localLocation;
-    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitBlameOutput);
     return job;
 }
 
-void GitPlugin::parseGitBlameOutput(DVcsJob *job)
-{
-    QVariantList results;
-    VcsAnnotationLine* annotation = nullptr;
-    const auto output = job->output();
-    const auto lines = output.splitRef('\n');
-
-    bool skipNext=false;
-    QMap<QString, VcsAnnotationLine> definedRevisions;
-    for(QVector<QStringRef>::const_iterator it=lines.constBegin(), itEnd=lines.constEnd();
-        it!=itEnd; ++it)
-    {
-        if(skipNext) {
-            skipNext=false;
-            results += qVariantFromValue(*annotation);
-
-            continue;
-        }
-
-        if(it->isEmpty())
-            continue;
-
-        QStringRef name = it->left(it->indexOf(' '));
-        QStringRef value = it->right(it->size()-name.size()-1);
-
-        if(name==QLatin1String("author"))
-            annotation->setAuthor(value.toString());
-        else if(name==QLatin1String("author-mail")) {} //TODO: do smth with the e-mail?
-        else if(name==QLatin1String("author-tz")) {} //TODO: does it really matter?
-        else if(name==QLatin1String("author-time"))
-            annotation->setDate(QDateTime::fromTime_t(value.toUInt()));
-        else if(name==QLatin1String("summary"))
-            annotation->setCommitMessage(value.toString());
-        else if(name.startsWith(QStringLiteral("committer"))) {} //We will just store the authors
-        else if(name==QLatin1String("previous")) {} //We don't need that either
-        else if(name==QLatin1String("filename")) { skipNext=true; }
-        else if(name==QLatin1String("boundary")) {
-            definedRevisions.insert(QStringLiteral("boundary"), VcsAnnotationLine());
-        }
-        else
-        {
-            const auto values = value.split(' ');
-
-            VcsRevision rev;
-            rev.setRevisionValue(name.left(8).toString(), KDevelop::VcsRevision::GlobalNumber);
-
-            skipNext = definedRevisions.contains(name.toString());
-
-            if(!skipNext)
-                definedRevisions.insert(name.toString(), VcsAnnotationLine());
-
-            annotation = &definedRevisions[name.toString()];
-            annotation->setLineNumber(values[1].toInt() - 1);
-            annotation->setRevision(rev);
-        }
-    }
-    job->setResults(results);
-}
-
 
 DVcsJob* GitPlugin::lsFiles(const QDir &repository, const QStringList &args,
                             OutputJob::OutputJobVerbosity verbosity)
@@ -1072,87 +1010,6 @@ void GitPlugin::parseLogOutput(const DVcsJob * job, QList<DVcsEvent>& commits) c
     }
 }
 
-VcsItemEvent::Actions actionsFromString(char c)
-{
-    switch(c) {
-        case 'A': return VcsItemEvent::Added;
-        case 'D': return VcsItemEvent::Deleted;
-        case 'R': return VcsItemEvent::Replaced;
-        case 'M': return VcsItemEvent::Modified;
-    }
-    return VcsItemEvent::Modified;
-}
-
-void GitPlugin::parseGitLogOutput(DVcsJob * job)
-{
-    static QRegExp commitRegex( "^commit (\\w{8})\\w{32}" );
-    static QRegExp infoRegex( "^(\\w+):(.*)" );
-    static QRegExp modificationsRegex("^([A-Z])[0-9]*\t([^\t]+)\t?(.*)", Qt::CaseSensitive, QRegExp::RegExp2);
-    //R099    plugins/git/kdevgit.desktop     plugins/git/kdevgit.desktop.cmake
-    //M       plugins/grepview/CMakeLists.txt
-
-    QList<QVariant> commits;
-
-    QString contents = job->output();
-    // check if git-log returned anything
-    if (contents.isEmpty()) {
-        job->setResults(commits); // empty list
-        return;
-    }
-
-    // start parsing the output
-    QTextStream s(&contents);
-
-    VcsEvent item;
-    QString message;
-    bool pushCommit = false;
-
-    while (!s.atEnd()) {
-        QString line = s.readLine();
-
-        if (commitRegex.exactMatch(line)) {
-            if (pushCommit) {
-                item.setMessage(message.trimmed());
-                commits.append(QVariant::fromValue(item));
-                item.setItems(QList<VcsItemEvent>());
-            } else {
-                pushCommit = true;
-            }
-            VcsRevision rev;
-            rev.setRevisionValue(commitRegex.cap(1), KDevelop::VcsRevision::GlobalNumber);
-            item.setRevision(rev);
-            message.clear();
-        } else if (infoRegex.exactMatch(line)) {
-            QString cap1 = infoRegex.cap(1);
-            if (cap1 == QLatin1String("Author")) {
-                item.setAuthor(infoRegex.cap(2).trimmed());
-            } else if (cap1 == QLatin1String("Date")) {
-                item.setDate(QDateTime::fromTime_t(infoRegex.cap(2).trimmed().split(' ')[0].toUInt()));
-            }
-        } else if (modificationsRegex.exactMatch(line)) {
-            VcsItemEvent::Actions a = actionsFromString(modificationsRegex.cap(1).at(0).toLatin1());
-            QString filenameA = modificationsRegex.cap(2);
-
-            VcsItemEvent itemEvent;
-            itemEvent.setActions(a);
-            itemEvent.setRepositoryLocation(filenameA);
-            if(a==VcsItemEvent::Replaced) {
-                QString filenameB = modificationsRegex.cap(3);
-                itemEvent.setRepositoryCopySourceLocation(filenameB);
-            }
-
-            item.addItem(itemEvent);
-        } else if (line.startsWith(QLatin1String("    "))) {
-            message += line.remove(0, 4);
-            message += '\n';
-        }
-    }
-
-    item.setMessage(message.trimmed());
-    commits.append(QVariant::fromValue(item));
-    job->setResults(commits);
-}
-
 void GitPlugin::parseGitDiffOutput(DVcsJob* job)
 {
     VcsDiff diff;
@@ -1214,7 +1071,7 @@ void GitPlugin::parseGitStatusOutput(DVcsJob* job)
     QDir dotGit = dotGitDirectory(QUrl::fromLocalFile(workingDir.absolutePath()));
 
     QVariantList statuses;
-    QList<QUrl> processedFiles;
+    QSet<QUrl> processedFiles;
 
     foreach(const QStringRef& line, outputLines) {
         //every line is 2 chars for the status, 1 space then the file desc
@@ -1227,7 +1084,7 @@ void GitPlugin::parseGitStatusOutput(DVcsJob* job)
             status.setUrl(QUrl::fromLocalFile(dotGit.absoluteFilePath(curr.toString().left(arrow))));
             status.setState(VcsStatusInfo::ItemDeleted);
             statuses.append(qVariantFromValue<VcsStatusInfo>(status));
-            processedFiles += status.url();
+            processedFiles.insert(status.url());
 
             curr = curr.mid(arrow+4);
         }
@@ -1239,7 +1096,7 @@ void GitPlugin::parseGitStatusOutput(DVcsJob* job)
         VcsStatusInfo status;
         status.setUrl(QUrl::fromLocalFile(dotGit.absoluteFilePath(curr.toString())));
         status.setState(messageToState(state));
-        processedFiles.append(status.url());
+        processedFiles.insert(status.url());
 
         qCDebug(PLUGIN_GIT) << "Checking git status for " << line << curr << status.state();
 
@@ -1253,6 +1110,7 @@ void GitPlugin::parseGitStatusOutput(DVcsJob* job)
 
     //here we add the already up to date files
     QStringList files = getLsFiles(job->directory(), QStringList() << QStringLiteral("-c") << QStringLiteral("--") << paths, OutputJob::Silent);
+    statuses.reserve(statuses.size() + files.size());
     foreach(const QString& file, files) {
         QUrl fileUrl = QUrl::fromLocalFile(workingDir.absoluteFilePath(file));
 
@@ -32,6 +32,7 @@
 
 #include <vcs/dvcs/dvcsjob.h>
 #include <vcs/vcsannotation.h>
+#include <vcs/vcsevent.h>
 #include "../gitplugin.h"
 
 #define VERIFYJOB(j) \
@@ -490,6 +491,39 @@ void GitInitTest::testAnnotation()
     QCOMPARE(annotation.commitMessage(), QStringLiteral("KDevelop's Test commit3"));
 }
 
+void GitInitTest::testLog()
+{
+    repoInit();
+    addFiles();
+    commitFiles();
+
+    const QUrl fileUrl = QUrl::fromLocalFile(gitTest_BaseDir() + gitTest_FileName());
+    VcsJob* j = m_plugin->log(fileUrl, VcsRevision::createSpecialRevision(VcsRevision::Head), 0);
+    VERIFYJOB(j);
+
+    QList<QVariant> results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 2);
+    QVERIFY(results.at(0).canConvert<VcsEvent>());
+    VcsEvent event = results.at(0).value<VcsEvent>();
+    QCOMPARE(event.message(), QStringLiteral("KDevelop's Test commit2"));
+    QCOMPARE(event.items().size(), 1);
+    QCOMPARE(event.items().at(0).repositoryLocation(), gitTest_FileName());
+    QCOMPARE(event.items().at(0).actions(), VcsItemEvent::Actions(VcsItemEvent::Modified));
+
+    event = results.at(1).value<VcsEvent>();
+    QCOMPARE(event.message(), QStringLiteral("Test commit"));
+    QCOMPARE(event.items().at(0).actions(), VcsItemEvent::Actions(VcsItemEvent::Added));
+
+    // everything has been fetched already
+    QVERIFY(j->fetchResults().toList().isEmpty());
+
+    j = m_plugin->log(fileUrl, VcsRevision::createSpecialRevision(VcsRevision::Head), 1);
+    VERIFYJOB(j);
+    results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).value<VcsEvent>().message(), QStringLiteral("KDevelop's Test commit2"));
+}
+
 void GitInitTest::testRemoveEmptyFolder()
 {
     repoInit();
@@ -58,6 +58,7 @@ private Q_SLOTS:
     void testMerge();
     void revHistory();
     void testAnnotation();
+    void testLog();
     void testRemoveEmptyFolder();
     void testRemoveEmptyFolderInFolder();
     void testRemoveUnindexedFile();
@@ -37,9 +37,16 @@
 #include <language/duchain/topducontext.h>
 #include <language/duchain/navigation/problemnavigationcontext.h>
 #include <language/editor/documentrange.h>
+#include <language/backgroundparser/backgroundparser.h>
+
+#include <util/texteditorhelpers.h>
 
 #include <kcolorscheme.h>
 
+#include <QTimer>
+
+#include <algorithm>
+
 #include <shell/problem.h>
 
 using namespace KTextEditor;
@@ -48,6 +55,11 @@ using namespace KDevelop;
 namespace
 {
 
+// Documents with more problems only get moving ranges around the visible region
+const int viewportHighlightingThreshold = 1000;
+// Number of lines above and below the visible region that are highlighted in such documents
+const int viewportMarginLines = 300;
+
 QColor colorForSeverity(IProblem::Severity severity)
 {
     KColorScheme scheme(QPalette::Active);
@@ -78,6 +90,20 @@ ProblemHighlighter::ProblemHighlighter(KTextEditor::Document* document)
     }
     connect(m_document, SIGNAL(aboutToRemoveText(KTextEditor::Range)), this,
             SLOT(aboutToRemoveText(KTextEditor::Range)));
+
+    m_viewportTimer = new QTimer(this);
+    m_viewportTimer->setSingleShot(true);
+    m_viewportTimer->setInterval(50);
+    connect(m_viewportTimer, &QTimer::timeout, this, &ProblemHighlighter::updateVisibleRanges);
+    connect(m_document.data(), &Document::viewCreated, this, &ProblemHighlighter::viewCreated);
+    foreach (View* view, m_document->views()) {
+        viewCreated(m_document, view);
+    }
+}
+
+void ProblemHighlighter::viewCreated(Document*, View* view)
+{
+    connect(view, &View::verticalScrollPositionChanged, m_viewportTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
 }
 
 void ProblemHighlighter::settingsChanged()
@@ -107,6 +133,9 @@ void ProblemHighlighter::setProblems(const QVector<IProblem::Ptr>& problems)
 
     qDeleteAll(m_topHLRanges);
     m_topHLRanges.clear();
+    m_ranges.clear();
+    m_revision = RevisionReference();
+    m_liveBegin = m_liveEnd = 0;
 
     IndexedString url(m_document->url());
 
@@ -130,13 +159,15 @@ void ProblemHighlighter::setProblems(const QVector<IProblem::Ptr>& problems)
         return;
     }
 
+    // The ranges get created for the current revision, keep it to map them through later edits
+    if (DocumentChangeTracker* tracker = ICore::self()->languageController()->backgroundParser()->trackerForUrl(url)) {
+        m_revision = tracker->currentRevision();
+    }
+
     DUChainReadLocker lock;
 
     TopDUContext* top = DUChainUtils::standardContextForUrl(m_document->url());
 
-    KTextEditor::MovingInterface* iface = dynamic_cast<KTextEditor::MovingInterface*>(m_document.data());
-    Q_ASSERT(iface);
-
     foreach (const IProblem::Ptr& problem, problems) {
         if (problem->finalLocation().document != url || !problem->finalLocation().isValid())
             continue;
@@ -179,8 +210,8 @@ void ProblemHighlighter::setProblems(const QVector<IProblem::Ptr>& problems)
             range.setEnd(range.end() + KTextEditor::Cursor(0, 1));
         }
 
-        KTextEditor::MovingRange* problemRange = iface->newMovingRange(range);
-        m_topHLRanges.append(problemRange);
+        ProblemRange problemRange;
+        problemRange.range = RangeInRevision::castFromSimpleRange(range);
 
         if (problem->source() != IProblem::ToDo
             && (problem->severity() != IProblem::Hint
@@ -188,8 +219,9 @@ void ProblemHighlighter::setProblems(const QVector<IProblem::Ptr>& problems)
             KTextEditor::Attribute::Ptr attribute(new KTextEditor::Attribute());
             attribute->setUnderlineStyle(QTextCharFormat::WaveUnderline);
             attribute->setUnderlineColor(colorForSeverity(problem->severity()));
-            problemRange->setAttribute(attribute);
+            problemRange.attribute = attribute;
         }
+        m_ranges.append(problemRange);
 
         if (markIface && ICore::self()->languageController()->completionSettings()->highlightProblematicLines()) {
             uint mark;
@@ -203,6 +235,76 @@ void ProblemHighlighter::setProblems(const QVector<IProblem::Ptr>& problems)
             markIface->addMark(problem->finalLocation().start().line(), mark);
         }
     }
+
+    lock.unlock();
+
+    std::stable_sort(m_ranges.begin(), m_ranges.end(), [](const ProblemRange& lhs, const ProblemRange& rhs) {
+        return lhs.range.start < rhs.range.start;
+    });
+    updateVisibleRanges();
+}
+
+void ProblemHighlighter::updateVisibleRanges()
+{
+    if (!m_document)
+        return;
+
+    int begin = 0;
+    int end = m_ranges.size();
+
+    if (m_ranges.size() > viewportHighlightingThreshold && m_revision) {
+        int firstLine = -1;
+        int lastLine = -1;
+        foreach (View* view, m_document->views()) {
+            if (!view->isVisible())
+                continue;
+            const KTextEditor::Range lines = KTextEditorHelpers::visibleLines(view);
+            firstLine = firstLine == -1 ? lines.start().line() : qMin(firstLine, lines.start().line());
+            lastLine = qMax(lastLine, lines.end().line());
+        }
+        if (firstLine == -1) {
+            firstLine = lastLine = 0;
+        }
+        // the problem ranges refer to the revision of the last setProblems(), map the visible lines back to it
+        const KTextEditor::Range visible(qMax(0, firstLine - viewportMarginLines), 0, lastLine + viewportMarginLines + 1, 0);
+        const RangeInRevision visibleInRevision = m_revision->transformFromCurrentRevision(visible);
+
+        auto lineLessThan = [](const ProblemRange& problemRange, int line) {
+            return problemRange.range.start.line < line;
+        };
+        begin = std::lower_bound(m_ranges.constBegin(), m_ranges.constEnd(), visibleInRevision.start.line, lineLessThan) - m_ranges.constBegin();
+        end = std::lower_bound(m_ranges.constBegin() + begin, m_ranges.constEnd(), visibleInRevision.end.line, lineLessThan) - m_ranges.constBegin();
+    }
+
+    if (begin == m_liveBegin && end == m_liveEnd && m_topHLRanges.size() == end - begin)
+        return;
+
+    KTextEditor::MovingInterface* iface = dynamic_cast<KTextEditor::MovingInterface*>(m_document.data());
+    Q_ASSERT(iface);
+
+    // Keep the ranges that stay visible, they have been moved along with the edits since
+    QVector<KTextEditor::MovingRange*> ranges;
+    ranges.reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        if (i >= m_liveBegin && i < m_liveBegin + m_topHLRanges.size()) {
+            ranges.append(m_topHLRanges[i - m_liveBegin]);
+        } else {
+            const KTextEditor::Range range = m_revision ? m_revision->transformToCurrentRevision(m_ranges[i].range)
+                                                        : m_ranges[i].range.castToSimpleRange();
+            KTextEditor::MovingRange* problemRange = iface->newMovingRange(range);
+            if (m_ranges[i].attribute)
+                problemRange->setAttribute(m_ranges[i].attribute);
+            ranges.append(problemRange);
+        }
+    }
+    for (int i = 0; i < m_topHLRanges.size(); ++i) {
+        if (m_liveBegin + i < begin || m_liveBegin + i >= end)
+            delete m_topHLRanges[i];
+    }
+
+    m_topHLRanges = ranges;
+    m_liveBegin = begin;
+    m_liveEnd = end;
 }
 
 void ProblemHighlighter::aboutToRemoveText(const KTextEditor::Range& range)
@@ -211,13 +313,11 @@ void ProblemHighlighter::aboutToRemoveText(const KTextEditor::Range& range)
         return;
     }
 
-    QList<MovingRange*>::iterator it = m_topHLRanges.begin();
-    while (it != m_topHLRanges.end()) {
-        if (range.contains((*it)->toRange())) {
-            delete (*it);
-            it = m_topHLRanges.erase(it);
-        } else {
-            ++it;
+    // The ranges are only cleared, so they keep matching their problem ranges
+    for (auto& problemRange : m_topHLRanges) {
+        if (problemRange && range.contains(problemRange->toRange())) {
+            delete problemRange;
+            problemRange = nullptr;
         }
     }
 }
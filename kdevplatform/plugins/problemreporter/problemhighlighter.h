@@ -24,10 +24,17 @@
 #define KDEVPLATFORM_PLUGIN_PROBLEMHIGHLIGHTER_H
 
 #include <language/duchain/problem.h>
+#include <language/backgroundparser/documentchangetracker.h>
 #include <qpointer.h>
 #include <ktexteditor/movingrange.h>
 #include <interfaces/iproblem.h>
 
+class QTimer;
+
+namespace KTextEditor {
+class View;
+}
+
 class ProblemHighlighter : public QObject
 {
     Q_OBJECT
@@ -40,10 +47,28 @@ public:
 private Q_SLOTS:
     void aboutToRemoveText(const KTextEditor::Range& range);
     void clearProblems();
+    void viewCreated(KTextEditor::Document*, KTextEditor::View* view);
+    /// Creates the moving ranges for problems that became visible, and deletes the ones far out of sight
+    void updateVisibleRanges();
 
 private:
+    struct ProblemRange
+    {
+        KDevelop::RangeInRevision range;
+        KTextEditor::Attribute::Ptr attribute;
+    };
+
     QPointer<KTextEditor::Document> m_document;
-    QList<KTextEditor::MovingRange*> m_topHLRanges;
+    // Sorted by start, m_topHLRanges[i] is the moving range for m_ranges[m_liveBegin + i],
+    // or zero if the text it covered was removed.
+    QVector<ProblemRange> m_ranges;
+    // The document revision m_ranges refer to, without it all problems get moving ranges right away
+    KDevelop::RevisionReference m_revision;
+    QVector<KTextEditor::MovingRange*> m_topHLRanges;
+    // With many problems, only the ones around the visible region get moving ranges
+    int m_liveBegin = 0;
+    int m_liveEnd = 0;
+    QTimer* m_viewportTimer;
     QVector<KDevelop::IProblem::Ptr> m_problems;
 
 public Q_SLOTS:
@@ -23,11 +23,14 @@
 
 #include <KConfigGroup>
 
+#include <algorithm>
+
 using namespace KDevelop;
 
 Filter::Filter()
     : targets(Files | Folders)
     , type(Exclusive)
+    , isSimpleGlob(false)
 {
 
 }
@@ -36,6 +39,7 @@ Filter::Filter(const SerializedFilter& filter)
     : pattern(QString(), Qt::CaseSensitive, QRegExp::WildcardUnix)
     , targets(filter.targets)
     , type(filter.type)
+    , isSimpleGlob(false)
 {
     QString pattern = filter.pattern;
     if (!filter.pattern.startsWith('/') && !filter.pattern.startsWith('*')) {
@@ -48,6 +52,50 @@ Filter::Filter(const SerializedFilter& filter)
         pattern.chop(1);
     }
     this->pattern.setPattern(pattern);
+
+    static const QString specialCharacters = QStringLiteral("?[]\\");
+    isSimpleGlob = std::none_of(pattern.constBegin(), pattern.constEnd(), [](const QChar c) {
+        return specialCharacters.contains(c);
+    });
+    if (isSimpleGlob) {
+        globParts = pattern.split(QLatin1Char('*')).toVector();
+    }
+}
+
+bool Filter::matches(const QString& relativePath) const
+{
+    if (!isSimpleGlob) {
+        return pattern.exactMatch(relativePath);
+    }
+
+    // "*" matches any sequence of characters, including slashes. So the first and last part
+    // must be a prefix and suffix, and the parts in between are searched for from left to right.
+    const QString& first = globParts.first();
+    if (globParts.size() == 1) {
+        return relativePath == first;
+    }
+    const QString& last = globParts.last();
+    if (!relativePath.startsWith(first) || !relativePath.endsWith(last)) {
+        return false;
+    }
+
+    int position = first.size();
+    const int end = relativePath.size() - last.size();
+    if (end < position) {
+        return false;
+    }
+    for (int i = 1; i < globParts.size() - 1; ++i) {
+        const QString& part = globParts.at(i);
+        if (part.isEmpty()) {
+            continue;
+        }
+        const int index = relativePath.indexOf(part, position);
+        if (index == -1 || index + part.size() > end) {
+            return false;
+        }
+        position = index + part.size();
+    }
+    return true;
 }
 
 SerializedFilter::SerializedFilter()
@@ -61,9 +61,21 @@ public:
             && filter.type == type;
     }
 
+    /**
+     * @return whether @p relativePath is matched exactly by the pattern
+     *
+     * Most patterns only use "*" wildcards, those are matched without going through QRegExp.
+     */
+    bool matches(const QString& relativePath) const;
+
     QRegExp pattern;
     Targets targets;
     Type type;
+
+private:
+    /// the pattern split at its "*" wildcards, only used when it has no other special characters
+    QVector<QString> globParts;
+    bool isSimpleGlob;
 };
 
 typedef QVector<Filter> Filters;
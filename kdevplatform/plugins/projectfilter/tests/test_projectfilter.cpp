@@ -356,6 +356,43 @@ static QVector<BenchData> createBenchData(const Path& base, int folderDepth, int
     return data;
 }
 
+void TestProjectFilter::globMatch()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, path);
+
+    const Filter filter(SerializedFilter(pattern, Filter::Files));
+    // the fast path must agree with the regular expression
+    QCOMPARE(filter.matches(path), filter.pattern.exactMatch(path));
+}
+
+void TestProjectFilter::globMatch_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("path");
+
+    const QStringList patterns = {
+        QStringLiteral(".*"), QStringLiteral("*.o"), QStringLiteral("*.so.*"), QStringLiteral("moc_*.cpp"),
+        QStringLiteral(".*.kate-swp"), QStringLiteral("*~"), QStringLiteral("/build"), QStringLiteral("/build/*"),
+        QStringLiteral("CVS"), QStringLiteral("*"), QStringLiteral("a*b*c"), QStringLiteral("file?.cpp"),
+        QStringLiteral("[ab].h")
+    };
+    const QStringList paths = {
+        QStringLiteral("/file.o"), QStringLiteral("/folder/.hidden"), QStringLiteral("/.hidden/file"),
+        QStringLiteral("/lib/libfoo.so.1"), QStringLiteral("/libfoo.so"), QStringLiteral("/src/moc_foo.cpp"),
+        QStringLiteral("/moc_.cpp"), QStringLiteral("/moc.cpp"), QStringLiteral("/.foo.cpp.kate-swp"),
+        QStringLiteral("/file.cpp~"), QStringLiteral("/build"), QStringLiteral("/build/foo"),
+        QStringLiteral("/src/build"), QStringLiteral("/CVS"), QStringLiteral("/src/CVS"), QStringLiteral("/CVS2"),
+        QStringLiteral("/abc"), QStringLiteral("/acb"), QStringLiteral("/a/b/c"), QStringLiteral("/file1.cpp"),
+        QStringLiteral("/a.h"), QStringLiteral("/")
+    };
+    for (const QString& pattern : patterns) {
+        for (const QString& path : paths) {
+            QTest::newRow(qPrintable(pattern + QLatin1String(" - ") + path)) << pattern << path;
+        }
+    }
+}
+
 void TestProjectFilter::bench()
 {
     QFETCH(TestFilter, filter);
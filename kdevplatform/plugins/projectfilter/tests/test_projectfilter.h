@@ -34,6 +34,9 @@ private Q_SLOTS:
     void match();
     void match_data();
 
+    void globMatch();
+    void globMatch_data();
+
     void bench();
     void bench_data();
 };
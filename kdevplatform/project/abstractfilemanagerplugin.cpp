@@ -24,9 +24,20 @@
 #include "projectmodel.h"
 #include "helper.h"
 
-#include <QHashIterator>
 #include <QFileInfo>
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+#include <algorithm>
 
 #include <KMessageBox>
 #include <KLocalizedString>
@@ -60,6 +71,19 @@ ProjectFolderItem* getParentFolder(ProjectBaseItem* item)
     }
 }
 
+/// time to collect file system changes before they get applied to the project tree
+const int changesDelay = 100;
+
+/// bump this when the format of the project snapshots changes
+const int snapshotVersion = 1;
+
+QString snapshotFile(IProject* project)
+{
+    const QByteArray hash = QCryptographicHash::hash(project->projectFile().pathOrUrl().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QLatin1String("/projectsnapshots/") + QString::fromLatin1(hash);
+}
+
 }
 
 //END Helper
@@ -72,6 +96,10 @@ public:
     explicit AbstractFileManagerPluginPrivate(AbstractFileManagerPlugin* qq)
         : q(qq)
     {
+        m_changesTimer.setSingleShot(true);
+        m_changesTimer.setInterval(changesDelay);
+        q->connect(&m_changesTimer, &QTimer::timeout,
+                   q, [this] { applyChanges(); });
     }
 
     AbstractFileManagerPlugin* q;
@@ -80,17 +108,40 @@ public:
      * The just returned must be started in one way or another for this method
      * to have any affect. The job will then auto-delete itself upon completion.
      */
-    Q_REQUIRED_RESULT KIO::Job* eventuallyReadFolder(ProjectFolderItem* item);
+    Q_REQUIRED_RESULT FileManagerListJob* eventuallyReadFolder(ProjectFolderItem* item);
     void addJobItems(FileManagerListJob* job,
                      ProjectFolderItem* baseItem,
                      const KIO::UDSEntryList& entries);
 
-    void deleted(const QString &path);
-    void created(const QString &path);
+    /// File system changes of a project reported by its watcher, waiting to be applied
+    struct PendingChanges
+    {
+        QSet<QString> created;
+        QSet<QString> deleted;
+        QSet<QString> dirty;
+    };
+
+    void deleted(IProject* project, const QString& path);
+    void created(IProject* project, const QString& path);
+    void dirty(IProject* project, const QString& path);
+    /// Apply all pending changes, collected ones are handled in one go
+    void applyChanges();
+    void applyChanges(IProject* project, const PendingChanges& changes);
 
     void projectClosing(IProject* project);
     void jobFinished(KJob* job);
 
+    /// Read the folder listings of @p project saved when it was closed the last time.
+    FolderListings loadSnapshot(IProject* project) const;
+    /// Save the listed folders of @p project as they are in the project tree, so that the next import can start from them.
+    void saveSnapshot(IProject* project);
+    /// Reload the restored @p folders which changed since they were listed, off the main thread.
+    void verifyRestoredFolders(IProject* project, const QHash<Path, qint64>& folders);
+
+    /// Watch @p folder and all sub folders already in the project tree for changes.
+    void watchFolder(ProjectFolderItem* folder);
+    /// Stop watching @p folder and all its sub folders, e.g. when it gets removed from the project tree.
+    void unwatchFolder(ProjectFolderItem* folder);
     /// Stops watching the given folder for changes, only useful for local files.
     void stopWatcher(ProjectFolderItem* folder);
     /// Continues watching the given folder for changes.
@@ -101,9 +152,16 @@ public:
     void removeFolder(ProjectFolderItem* folder);
 
     QHash<IProject*, KDirWatch*> m_watchers;
+    QHash<IProject*, PendingChanges> m_pendingChanges;
+    QTimer m_changesTimer;
     QHash<IProject*, QList<FileManagerListJob*> > m_projectJobs;
     QVector<QString> m_stoppedFolders;
     ProjectFilterManager m_filters;
+    /// the folders listed for each project with their modification time at that point,
+    /// their entries are taken from the project tree when the snapshot gets saved
+    QHash<IProject*, QHash<Path, qint64>> m_listedFolders;
+    /// the snapshots loaded for the first import of a project
+    QHash<IProject*, FolderListings> m_snapshots;
 };
 
 void AbstractFileManagerPluginPrivate::projectClosing(IProject* project)
@@ -117,11 +175,138 @@ void AbstractFileManagerPluginPrivate::projectClosing(IProject* project)
         }
         m_projectJobs.remove(project);
     }
+    saveSnapshot(project);
+    m_snapshots.remove(project);
+    m_pendingChanges.remove(project);
     delete m_watchers.take(project);
     m_filters.remove(project);
 }
 
-KIO::Job* AbstractFileManagerPluginPrivate::eventuallyReadFolder(ProjectFolderItem* item)
+FolderListings AbstractFileManagerPluginPrivate::loadSnapshot(IProject* project) const
+{
+    FolderListings snapshot;
+    if (!project->path().isLocalFile()) {
+        return snapshot;
+    }
+
+    QFile file(snapshotFile(project));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return snapshot;
+    }
+
+    QDataStream stream(&file);
+    int version = 0;
+    int count = 0;
+    stream >> version >> count;
+    if (version != snapshotVersion) {
+        return snapshot;
+    }
+    snapshot.reserve(count);
+    for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        FolderListing listing;
+        stream >> path >> listing.lastModified >> listing.entries;
+        snapshot.insert(Path(path), listing);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(FILEMANAGER) << "ignoring corrupted project snapshot" << file.fileName();
+        return {};
+    }
+    qCDebug(FILEMANAGER) << "loaded snapshot of" << snapshot.size() << "folders for" << project->name();
+    return snapshot;
+}
+
+void AbstractFileManagerPluginPrivate::saveSnapshot(IProject* project)
+{
+    const QHash<Path, qint64> listedFolders = m_listedFolders.take(project);
+    if (listedFolders.isEmpty()) {
+        return;
+    }
+
+    // the project tree holds the entries of the listed folders, including the changes applied since
+    FolderListings folders;
+    folders.reserve(listedFolders.size());
+    for (auto it = listedFolders.constBegin(); it != listedFolders.constEnd(); ++it) {
+        const QList<ProjectFolderItem*> items = project->foldersForPath(IndexedString(it.key().pathOrUrl()));
+        if (items.isEmpty()) {
+            // removed or filtered in the meantime
+            continue;
+        }
+        const ProjectFolderItem* item = items.first();
+        FolderListing& listing = folders[it.key()];
+        listing.lastModified = it.value();
+        for (int i = 0; i < item->rowCount(); ++i) {
+            const ProjectBaseItem* child = item->child(i);
+            if (!child->folder() && !child->file()) {
+                continue;
+            }
+            KIO::UDSEntry entry;
+            entry.insert(KIO::UDSEntry::UDS_NAME, child->path().lastPathSegment());
+            if (child->folder()) {
+                entry.insert(KIO::UDSEntry::UDS_FILE_TYPE, QT_STAT_DIR);
+            }
+            listing.entries << entry;
+        }
+    }
+
+    const QString fileName = snapshotFile(project);
+    QDir().mkpath(QFileInfo(fileName).path());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(FILEMANAGER) << "failed to save the project snapshot" << fileName << file.errorString();
+        return;
+    }
+    QDataStream stream(&file);
+    stream << snapshotVersion << folders.size();
+    for (auto it = folders.constBegin(); it != folders.constEnd(); ++it) {
+        stream << it.key().pathOrUrl() << it->lastModified << it->entries;
+    }
+    if (!file.commit()) {
+        qCWarning(FILEMANAGER) << "failed to save the project snapshot" << fileName << file.errorString();
+    }
+}
+
+void AbstractFileManagerPluginPrivate::verifyRestoredFolders(IProject* project, const QHash<Path, qint64>& folders)
+{
+    auto watcher = new QFutureWatcher<Path::List>(q);
+    QPointer<IProject> guard(project);
+    q->connect(watcher, &QFutureWatcher<Path::List>::finished, q, [this, watcher, guard] () {
+        watcher->deleteLater();
+        if (!guard || !m_watchers.contains(guard.data())) {
+            // project got closed in the meantime
+            return;
+        }
+
+        // parents sort before their children, and reloading a folder reloads its sub folders, too
+        Path::List changed = watcher->result();
+        std::sort(changed.begin(), changed.end());
+        Path::List reloaded;
+        for (const Path& path : changed) {
+            if (!reloaded.isEmpty() && reloaded.last().isParentOf(path)) {
+                continue;
+            }
+            foreach (ProjectFolderItem* folder, guard->foldersForPath(IndexedString(path.pathOrUrl()))) {
+                auto job = eventuallyReadFolder(folder);
+                job->start();
+            }
+            reloaded << path;
+        }
+        qCDebug(FILEMANAGER) << "reloading" << reloaded.size() << "folders which changed since the last session of" << guard->name();
+    });
+
+    watcher->setFuture(QtConcurrent::run([folders] () {
+        Path::List changed;
+        for (auto it = folders.constBegin(); it != folders.constEnd(); ++it) {
+            const QFileInfo info(it.key().toLocalFile());
+            if (!info.exists() || info.lastModified().toMSecsSinceEpoch() != it.value()) {
+                changed << it.key();
+            }
+        }
+        return changed;
+    }));
+}
+
+FileManagerListJob* AbstractFileManagerPluginPrivate::eventuallyReadFolder(ProjectFolderItem* item)
 {
     FileManagerListJob* listJob = new FileManagerListJob( item );
     m_projectJobs[ item->project() ] << listJob;
@@ -134,6 +319,11 @@ KIO::Job* AbstractFileManagerPluginPrivate::eventuallyReadFolder(ProjectFolderIt
                 q, [&] (FileManagerListJob* job, ProjectFolderItem* baseItem, const KIO::UDSEntryList& entries) {
                     addJobItems(job, baseItem, entries); } );
 
+    IProject* project = item->project();
+    q->connect( listJob, &FileManagerListJob::listed,
+                q, [this, project] (const Path& path, const FolderListing& listing) {
+                    m_listedFolders[project].insert(path, listing.lastModified); } );
+
     return listJob;
 }
 
@@ -142,7 +332,12 @@ void AbstractFileManagerPluginPrivate::jobFinished(KJob* job)
     FileManagerListJob* gmlJob = qobject_cast<FileManagerListJob*>(job);
     if (gmlJob) {
         ifDebug(qCDebug(FILEMANAGER) << job << gmlJob << gmlJob->item();)
-        m_projectJobs[ gmlJob->item()->project() ].removeOne( gmlJob );
+        IProject* project = gmlJob->item()->project();
+        m_projectJobs[ project ].removeOne( gmlJob );
+        const auto restored = gmlJob->restoredFolders();
+        if (!gmlJob->error() && !restored.isEmpty()) {
+            verifyRestoredFolders(project, restored);
+        }
     } else {
         // job emitted its finished signal from its destructor
         // ensure we don't keep a dangling point in our list
@@ -212,7 +407,9 @@ void AbstractFileManagerPluginPrivate::addJobItems(FileManagerListJob* job,
                 // this folder already exists in the view
                 folders.remove( index );
                 // no need to add this item, but we still want to recurse into it
-                job->addSubDir( f );
+                if ( job->isRecursive() ) {
+                    job->addSubDir( f );
+                }
                 emit q->reloadedFolderItem( f );
             }
         } else if ( ProjectFileItem* f =  baseItem->child(j)->file() ) {
@@ -241,111 +438,136 @@ void AbstractFileManagerPluginPrivate::addJobItems(FileManagerListJob* job,
     foreach ( const Path& path, folders ) {
         ProjectFolderItem* folder = q->createFolderItem( baseItem->project(), path, baseItem );
         if (folder) {
+            watchFolder( folder );
             emit q->folderAdded( folder );
             job->addSubDir( folder );
         }
     }
 }
 
-void AbstractFileManagerPluginPrivate::created(const QString& path_)
+void AbstractFileManagerPluginPrivate::created(IProject* project, const QString& path)
 {
-    qCDebug(FILEMANAGER) << "created:" << path_;
-    QFileInfo info(path_);
-
-    ///FIXME: share memory with parent
-    const Path path(path_);
-    const IndexedString indexedPath(path.pathOrUrl());
-    const IndexedString indexedParent(path.parent().pathOrUrl());
-
-    QHashIterator<IProject*, KDirWatch*> it(m_watchers);
-    while (it.hasNext()) {
-        const auto p = it.next().key();
-        if ( !p->projectItem()->model() ) {
-            // not yet finished with loading
-            // FIXME: how should this be handled? see unit test
-            continue;
-        }
-        if ( !q->isValid(path, info.isDir(), p) ) {
-            continue;
-        }
-        if ( info.isDir() ) {
-            bool found = false;
-            foreach ( ProjectFolderItem* folder, p->foldersForPath(indexedPath) ) {
-                // exists already in this project, happens e.g. when we restart the dirwatcher
-                // or if we delete and remove folders consecutively https://bugs.kde.org/show_bug.cgi?id=260741
-                qCDebug(FILEMANAGER) << "force reload of" << path << folder;
-                auto job = eventuallyReadFolder( folder );
-                job->start();
-                found = true;
-            }
-            if ( found ) {
-                continue;
-            }
-        } else if (!p->filesForPath(indexedPath).isEmpty()) {
-            // also gets triggered for kate's backup files
-            continue;
-        }
-        foreach ( ProjectFolderItem* parentItem, p->foldersForPath(indexedParent) ) {
-            if ( info.isDir() ) {
-                ProjectFolderItem* folder = q->createFolderItem( p, path, parentItem );
-                if (folder) {
-                    emit q->folderAdded( folder );
-                    auto job = eventuallyReadFolder( folder );
-                    job->start();
-                }
-            } else {
-                ProjectFileItem* file = q->createFileItem( p, path, parentItem );
-                if (file) {
-                    emit q->fileAdded( file );
-                }
-            }
-        }
+    ifDebug(qCDebug(FILEMANAGER) << "created:" << path;)
+    m_pendingChanges[project].created.insert(path);
+    if (!m_changesTimer.isActive()) {
+        m_changesTimer.start();
     }
 }
 
-void AbstractFileManagerPluginPrivate::deleted(const QString& path_)
+void AbstractFileManagerPluginPrivate::deleted(IProject* project, const QString& path)
 {
-    if ( QFile::exists(path_) ) {
-        // stopDirScan...
-        return;
-    }
     // ensure that the path is not inside a stopped folder
     foreach(const QString& folder, m_stoppedFolders) {
-        if (path_.startsWith(folder)) {
+        if (path.startsWith(folder)) {
             return;
         }
     }
-    qCDebug(FILEMANAGER) << "deleted:" << path_;
-
-    const Path path(QUrl::fromLocalFile(path_));
-    const IndexedString indexed(path.pathOrUrl());
-
-    QHashIterator<IProject*, KDirWatch*> it(m_watchers);
-    while (it.hasNext()) {
-        const auto p = it.next().key();
-        if (path == p->path()) {
-            KMessageBox::error(qApp->activeWindow(),
-                               i18n("The base folder of project <b>%1</b>"
-                                    " got deleted or moved outside of KDevelop.\n"
-                                    "The project has to be closed.", p->name()),
-                               i18n("Project Folder Deleted") );
-            ICore::self()->projectController()->closeProject(p);
+    ifDebug(qCDebug(FILEMANAGER) << "deleted:" << path;)
+
+    if (Path(QUrl::fromLocalFile(path)) == project->path()) {
+        if (QFile::exists(path)) {
+            // stopDirScan...
+            return;
+        }
+        KMessageBox::error(qApp->activeWindow(),
+                           i18n("The base folder of project <b>%1</b>"
+                                " got deleted or moved outside of KDevelop.\n"
+                                "The project has to be closed.", project->name()),
+                           i18n("Project Folder Deleted") );
+        ICore::self()->projectController()->closeProject(project);
+        return;
+    }
+
+    m_pendingChanges[project].deleted.insert(path);
+    if (!m_changesTimer.isActive()) {
+        m_changesTimer.start();
+    }
+}
+
+void AbstractFileManagerPluginPrivate::dirty(IProject* project, const QString& path)
+{
+    // also reported for modified files, those are sorted out when the changes get applied
+    m_pendingChanges[project].dirty.insert(path);
+    if (!m_changesTimer.isActive()) {
+        m_changesTimer.start();
+    }
+}
+
+void AbstractFileManagerPluginPrivate::applyChanges()
+{
+    const auto pending = m_pendingChanges;
+    m_pendingChanges.clear();
+
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        IProject* project = it.key();
+        if (!project->projectItem()->model()) {
+            // not yet finished with loading, keep the changes until it is
+            m_pendingChanges.insert(project, it.value());
             continue;
         }
-        if ( !p->projectItem()->model() ) {
-            // not yet finished with loading
-            // FIXME: how should this be handled? see unit test
+        applyChanges(project, it.value());
+    }
+
+    if (!m_pendingChanges.isEmpty()) {
+        m_changesTimer.start();
+    }
+}
+
+void AbstractFileManagerPluginPrivate::applyChanges(IProject* project, const PendingChanges& changes)
+{
+    // parents sort before their children, which then are gone already
+    QStringList deleted = changes.deleted.toList();
+    std::sort(deleted.begin(), deleted.end());
+    foreach (const QString& path, deleted) {
+        if (QFile::exists(path)) {
+            // got recreated in the meantime or stopDirScan...
             continue;
         }
-        foreach ( ProjectFolderItem* item, p->foldersForPath(indexed) ) {
+        const IndexedString indexed(Path(QUrl::fromLocalFile(path)).pathOrUrl());
+        foreach ( ProjectFolderItem* item, project->foldersForPath(indexed) ) {
             removeFolder(item);
         }
-        foreach ( ProjectFileItem* item, p->filesForPath(indexed) ) {
+        foreach ( ProjectFileItem* item, project->filesForPath(indexed) ) {
             emit q->fileRemoved(item);
             ifDebug(qCDebug(FILEMANAGER) << "removing file" << item;)
             item->parent()->removeRow(item->row());
         }
     }
+
+    // folders to reload recursively
+    QSet<ProjectFolderItem*> reload;
+    // folders whose direct entries are compared to the project tree again,
+    // this also adds new entries which are created or moved into them
+    QSet<ProjectFolderItem*> relist;
+    foreach (const QString& path_, changes.created) {
+        const Path path(QUrl::fromLocalFile(path_));
+        const auto existing = project->foldersForPath(IndexedString(path.pathOrUrl()));
+        if (!existing.isEmpty()) {
+            // exists already in this project, happens e.g. when we restart the dirwatcher
+            // or if we delete and remove folders consecutively https://bugs.kde.org/show_bug.cgi?id=260741
+            reload += existing.toSet();
+        } else {
+            relist += project->foldersForPath(IndexedString(path.parent().pathOrUrl())).toSet();
+        }
+    }
+    foreach (const QString& path, changes.dirty) {
+        relist += project->foldersForPath(IndexedString(Path(QUrl::fromLocalFile(path)).pathOrUrl())).toSet();
+    }
+    relist -= reload;
+
+    qCDebug(FILEMANAGER) << "applying file system changes to" << project->name() << ":"
+                         << deleted.size() << "deleted," << reload.size() << "reloaded and"
+                         << relist.size() << "changed folders";
+
+    foreach (ProjectFolderItem* folder, reload) {
+        auto job = eventuallyReadFolder(folder);
+        job->start();
+    }
+    foreach (ProjectFolderItem* folder, relist) {
+        auto job = eventuallyReadFolder(folder);
+        job->setRecursive(false);
+        job->start();
+    }
 }
 
 bool AbstractFileManagerPluginPrivate::rename(ProjectBaseItem* item, const Path& newPath)
@@ -366,6 +588,9 @@ bool AbstractFileManagerPluginPrivate::rename(ProjectBaseItem* item, const Path&
             const Path source = item->path();
             bool success = renameUrl( item->project(), source.toUrl(), newPath.toUrl() );
             if ( success ) {
+                if (item->folder()) {
+                    unwatchFolder(item->folder());
+                }
                 item->setPath( newPath );
                 item->parent()->takeRow( item->row() );
                 parent->appendRow( item );
@@ -373,6 +598,7 @@ bool AbstractFileManagerPluginPrivate::rename(ProjectBaseItem* item, const Path&
                     emit q->fileRenamed(source, item->file());
                 } else {
                     Q_ASSERT(item->folder());
+                    watchFolder(item->folder());
                     emit q->folderRenamed(source, item->folder());
                 }
             }
@@ -383,6 +609,31 @@ bool AbstractFileManagerPluginPrivate::rename(ProjectBaseItem* item, const Path&
     return false;
 }
 
+void AbstractFileManagerPluginPrivate::watchFolder(ProjectFolderItem* folder)
+{
+    KDirWatch* watcher = m_watchers.value(folder->project());
+    if (!watcher) {
+        return;
+    }
+    // only folders which pass the project filters are watched, e.g. no VCS metadata or build folders
+    watcher->addDir(folder->path().toLocalFile(), KDirWatch::WatchFiles);
+    foreach (ProjectFolderItem* child, folder->folderList()) {
+        watchFolder(child);
+    }
+}
+
+void AbstractFileManagerPluginPrivate::unwatchFolder(ProjectFolderItem* folder)
+{
+    KDirWatch* watcher = m_watchers.value(folder->project());
+    if (!watcher) {
+        return;
+    }
+    watcher->removeDir(folder->path().toLocalFile());
+    foreach (ProjectFolderItem* child, folder->folderList()) {
+        unwatchFolder(child);
+    }
+}
+
 void AbstractFileManagerPluginPrivate::stopWatcher(ProjectFolderItem* folder)
 {
     if ( !folder->path().isLocalFile() ) {
@@ -431,6 +682,7 @@ void AbstractFileManagerPluginPrivate::removeFolder(ProjectFolderItem* folder)
             job->removeSubDir(folder);
         }
     }
+    unwatchFolder(folder);
     folder->parent()->removeRow( folder->row() );
 }
 
@@ -472,24 +724,44 @@ ProjectFolderItem *AbstractFileManagerPlugin::import( IProject *project )
 
     ///TODO: check if this works for remote files when something gets changed through another KDE app
     if ( project->path().isLocalFile() ) {
-        d->m_watchers[project] = new KDirWatch( project );
-
-        connect(d->m_watchers[project], &KDirWatch::created,
-                this, [&] (const QString& path_) { d->created(path_); });
-        connect(d->m_watchers[project], &KDirWatch::deleted,
-                this, [&] (const QString& path_) { d->deleted(path_); });
-
-        d->m_watchers[project]->addDir(project->path().toLocalFile(), KDirWatch::WatchSubDirs | KDirWatch:: WatchFiles );
+        KDirWatch* watcher = new KDirWatch( project );
+        d->m_watchers[project] = watcher;
+
+        // the changes are only collected here and applied in batches, see applyChanges()
+        connect(watcher, &KDirWatch::created,
+                this, [this, project] (const QString& path) { d->created(project, path); });
+        connect(watcher, &KDirWatch::deleted,
+                this, [this, project] (const QString& path) { d->deleted(project, path); });
+        connect(watcher, &KDirWatch::dirty,
+                this, [this, project] (const QString& path) { d->dirty(project, path); });
+
+        // sub folders get watched once they are added to the project tree
+        d->watchFolder(projectRoot);
     }
 
     d->m_filters.add(project);
 
+    if (!d->m_listedFolders.contains(project)) {
+        // first import in this session, start from the state of the last one
+        const FolderListings snapshot = d->loadSnapshot(project);
+        QHash<Path, qint64>& listedFolders = d->m_listedFolders[project];
+        for (auto it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+            listedFolders.insert(it.key(), it->lastModified);
+        }
+        d->m_snapshots.insert(project, snapshot);
+    }
+
     return projectRoot;
 }
 
 KJob* AbstractFileManagerPlugin::createImportJob(ProjectFolderItem* item)
 {
-    return d->eventuallyReadFolder(item);
+    auto job = d->eventuallyReadFolder(item);
+    if (!item->parent()) {
+        // restore the folders from the snapshot, they get verified once the import is done
+        job->setSnapshot(d->m_snapshots.take(item->project()));
+    }
+    return job;
 }
 
 bool AbstractFileManagerPlugin::reload( ProjectFolderItem* item )
@@ -509,6 +781,7 @@ ProjectFolderItem* AbstractFileManagerPlugin::addFolder( const Path& folder,
     if ( createFolder(folder.toUrl()) ) {
         created = createFolderItem( parent->project(), folder, parent );
         if (created) {
+            d->watchFolder(created);
             emit folderAdded(created);
         }
     }
@@ -562,6 +835,7 @@ bool AbstractFileManagerPlugin::removeFilesAndFolders(const QList<ProjectBaseIte
             } else {
                 Q_ASSERT(item->folder());
                 emit folderRemoved(item->folder());
+                d->unwatchFolder(item->folder());
             }
             item->parent()->removeRow( item->row() );
         }
@@ -593,6 +867,7 @@ bool AbstractFileManagerPlugin::moveFilesAndFolders(const QList< ProjectBaseItem
                 emit fileRemoved(item->file());
             } else {
                 emit folderRemoved(item->folder());
+                d->unwatchFolder(item->folder());
             }
             oldParent->removeRow( item->row() );
             KIO::Job *readJob = d->eventuallyReadFolder(newParent);
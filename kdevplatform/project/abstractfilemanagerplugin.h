@@ -100,6 +100,8 @@ protected:
 
     /**
      * @return the @c KDirWatch for the given @p project.
+     *
+     * Only the folders in the project tree are watched, i.e. filtered folders are skipped.
      */
     KDirWatch* projectWatcher( IProject* project ) const;
 
@@ -26,14 +26,25 @@
 #include "debug.h"
 
 #include <QtConcurrentRun>
+#include <QFutureWatcher>
+#include <QDateTime>
 #include <QDir>
+#include <QThreadPool>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <dirent.h>
+#endif
 
 using namespace KDevelop;
 
 FileManagerListJob::FileManagerListJob(ProjectFolderItem* item)
-    : KIO::Job(), m_item(item), m_aborted(false)
+    : KIO::Job(), m_item(item), m_aborted(new QAtomicInt(false))
 {
     qRegisterMetaType<KIO::UDSEntryList>("KIO::UDSEntryList");
+    qRegisterMetaType<KDevelop::Path>();
+    qRegisterMetaType<KDevelop::FolderListing>();
     qRegisterMetaType<KIO::Job*>();
     qRegisterMetaType<KJob*>();
 
@@ -49,6 +60,12 @@ FileManagerListJob::FileManagerListJob(ProjectFolderItem* item)
 #endif
 }
 
+FileManagerListJob::~FileManagerListJob()
+{
+    // listings still running in the thread pool are not needed anymore
+    *m_aborted = true;
+}
+
 ProjectFolderItem* FileManagerListJob::item() const
 {
     return m_item;
@@ -65,6 +82,28 @@ void FileManagerListJob::addSubDir( ProjectFolderItem* item )
 void FileManagerListJob::removeSubDir(ProjectFolderItem* item)
 {
     m_listQueue.removeAll(item);
+    m_prefetching.remove(item->path());
+    m_prefetched.remove(item->path());
+}
+
+void FileManagerListJob::setSnapshot(const FolderListings& snapshot)
+{
+    m_snapshot = snapshot;
+}
+
+QHash<Path, qint64> FileManagerListJob::restoredFolders() const
+{
+    return m_restored;
+}
+
+void FileManagerListJob::setRecursive(bool recursive)
+{
+    m_recursive = recursive;
+}
+
+bool FileManagerListJob::isRecursive() const
+{
+    return m_recursive;
 }
 
 void FileManagerListJob::slotEntries(KIO::Job* job, const KIO::UDSEntryList& entriesIn)
@@ -73,9 +112,129 @@ void FileManagerListJob::slotEntries(KIO::Job* job, const KIO::UDSEntryList& ent
     entryList.append(entriesIn);
 }
 
+namespace {
+
+KIO::UDSEntry entryForFileInfo(const QFileInfo& info)
+{
+    KIO::UDSEntry entry;
+    entry.insert(KIO::UDSEntry::UDS_NAME, info.fileName());
+    if (info.isDir()) {
+        entry.insert(KIO::UDSEntry::UDS_FILE_TYPE, QT_STAT_DIR);
+    }
+    if (info.isSymLink()) {
+        entry.insert(KIO::UDSEntry::UDS_LINK_DEST, info.symLinkTarget());
+    }
+    return entry;
+}
+
+KIO::UDSEntryList listLocalFolder(const QString& folder)
+{
+    KIO::UDSEntryList results;
+#ifdef Q_OS_UNIX
+    // readdir gives us the file type for free on most file systems,
+    // while QFileInfo needs to stat every single entry
+    const QByteArray encodedFolder = QFile::encodeName(folder);
+    if (DIR* dir = opendir(encodedFolder.constData())) {
+        while (dirent* dirEntry = readdir(dir)) {
+            const char* name = dirEntry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+            const QString fileName = QFile::decodeName(name);
+            if (dirEntry->d_type == DT_REG) {
+                KIO::UDSEntry entry;
+                entry.insert(KIO::UDSEntry::UDS_NAME, fileName);
+                results << entry;
+            } else if (dirEntry->d_type == DT_DIR) {
+                KIO::UDSEntry entry;
+                entry.insert(KIO::UDSEntry::UDS_NAME, fileName);
+                entry.insert(KIO::UDSEntry::UDS_FILE_TYPE, QT_STAT_DIR);
+                results << entry;
+            } else {
+                // symlinks and file systems without d_type support
+                const QFileInfo info(folder + QLatin1Char('/') + fileName);
+                if (!info.isFile() && !info.isDir()) {
+                    // like QDir::AllEntries, skip fifos, sockets, devices and broken symlinks
+                    continue;
+                }
+                results << entryForFileInfo(info);
+            }
+        }
+        closedir(dir);
+    }
+    // keep the order QDir would give us
+    std::sort(results.begin(), results.end(), [] (const KIO::UDSEntry& lhs, const KIO::UDSEntry& rhs) {
+        return lhs.stringValue(KIO::UDSEntry::UDS_NAME).compare(rhs.stringValue(KIO::UDSEntry::UDS_NAME), Qt::CaseInsensitive) < 0;
+    });
+#else
+    QDir dir(folder);
+    const auto entries = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries | QDir::Hidden);
+    std::transform(entries.begin(), entries.end(), std::back_inserter(results), entryForFileInfo);
+#endif
+    return results;
+}
+
+}
+
+void FileManagerListJob::startLocalListing(const Path& path)
+{
+    m_prefetching.insert(path);
+
+    // the watcher goes away with the job, the listing itself must not touch the job
+    auto watcher = new QFutureWatcher<FolderListing>(this);
+    connect(watcher, &QFutureWatcher<FolderListing>::finished, this, [this, watcher, path] () {
+        watcher->deleteLater();
+        localListingDone(path, watcher->result());
+    });
+
+    const QSharedPointer<QAtomicInt> aborted = m_aborted;
+    watcher->setFuture(QtConcurrent::run([aborted] (const Path& path) {
+        FolderListing listing;
+        if (*aborted) {
+            return listing;
+        }
+        const QString localPath = path.toLocalFile();
+        // take the time before listing, a change while listing is then noticed the next time
+        listing.lastModified = QFileInfo(localPath).lastModified().toMSecsSinceEpoch();
+        listing.entries = listLocalFolder(localPath);
+        return listing;
+    }, path));
+}
+
+void FileManagerListJob::prefetchLocalFolders()
+{
+    // list a few folders ahead in parallel, their results are handled in queue order
+    const int maxPrefetching = qMax(2, QThreadPool::globalInstance()->maxThreadCount());
+    for (int i = 0; i < m_listQueue.size() && m_prefetching.size() < maxPrefetching; ++i) {
+        const Path path = m_listQueue.at(i)->path();
+        if (!path.isLocalFile() || m_prefetching.contains(path) || m_snapshot.contains(path)) {
+            continue;
+        }
+        startLocalListing(path);
+    }
+}
+
+void FileManagerListJob::localListingDone(const Path& path, const FolderListing& listing)
+{
+    if (*m_aborted || !m_prefetching.contains(path)) {
+        // the folder got removed in the meantime
+        return;
+    }
+
+    m_prefetched.insert(path, listing);
+
+    if (m_waitingForPrefetch && m_item && m_item->path() == path) {
+        m_waitingForPrefetch = false;
+        m_prefetching.remove(path);
+        const FolderListing listing = m_prefetched.take(path);
+        emit listed(path, listing);
+        handleResults(listing.entries);
+    }
+}
+
 void FileManagerListJob::startNextJob()
 {
-    if ( m_listQueue.isEmpty() || m_aborted ) {
+    if ( m_listQueue.isEmpty() || *m_aborted ) {
         return;
     }
 
@@ -85,30 +244,33 @@ void FileManagerListJob::startNextJob()
 
     m_item = m_listQueue.dequeue();
     if (m_item->path().isLocalFile()) {
-        // optimized version for local projects using QDir directly
-        QtConcurrent::run([this] (const Path& path) {
-            if (m_aborted) {
-                return;
-            }
-            QDir dir(path.toLocalFile());
-            const auto entries = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries | QDir::Hidden);
-            if (m_aborted) {
-                return;
-            }
-            KIO::UDSEntryList results;
-            std::transform(entries.begin(), entries.end(), std::back_inserter(results), [] (const QFileInfo& info) -> KIO::UDSEntry {
-                KIO::UDSEntry entry;
-                entry.insert(KIO::UDSEntry::UDS_NAME, info.fileName());
-                if (info.isDir()) {
-                    entry.insert(KIO::UDSEntry::UDS_FILE_TYPE, QT_STAT_DIR);
-                }
-                if (info.isSymLink()) {
-                    entry.insert(KIO::UDSEntry::UDS_LINK_DEST, info.symLinkTarget());
-                }
-                return entry;
-            });
-            QMetaObject::invokeMethod(this, "handleResults", Q_ARG(KIO::UDSEntryList, results));
-        }, m_item->path());
+        // optimized version for local projects using the file system directly
+        const Path path = m_item->path();
+        auto restored = m_snapshot.find(path);
+        if (restored != m_snapshot.end()) {
+            // no need to touch the file system, the caller checks the restored folders later on
+            const KIO::UDSEntryList entries = restored->entries;
+            m_restored.insert(path, restored->lastModified);
+            m_snapshot.erase(restored);
+            handleResults(entries);
+            return;
+        }
+
+        if (!m_prefetching.contains(path)) {
+            startLocalListing(path);
+        }
+        prefetchLocalFolders();
+
+        auto it = m_prefetched.find(path);
+        if (it != m_prefetched.end()) {
+            const FolderListing listing = *it;
+            m_prefetched.erase(it);
+            m_prefetching.remove(path);
+            emit listed(path, listing);
+            handleResults(listing.entries);
+        } else {
+            m_waitingForPrefetch = true;
+        }
     } else {
         KIO::ListJob* job = KIO::listDir( m_item->path().toUrl(), KIO::HideProgressInfo );
         job->addMetaData(QStringLiteral("details"), QStringLiteral("0"));
@@ -121,7 +283,7 @@ void FileManagerListJob::startNextJob()
 
 void FileManagerListJob::slotResult(KJob* job)
 {
-    if (m_aborted) {
+    if (*m_aborted) {
         return;
     }
 
@@ -136,7 +298,7 @@ void FileManagerListJob::slotResult(KJob* job)
 
 void FileManagerListJob::handleResults(const KIO::UDSEntryList& entriesIn)
 {
-    if (m_aborted) {
+    if (*m_aborted) {
         return;
     }
 
@@ -163,7 +325,7 @@ void FileManagerListJob::handleResults(const KIO::UDSEntryList& entriesIn)
 
 void FileManagerListJob::abort()
 {
-    m_aborted = true;
+    *m_aborted = true;
 
     bool killed = kill();
     Q_ASSERT(killed);
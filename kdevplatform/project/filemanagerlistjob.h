@@ -21,7 +21,12 @@
 #define KDEVPLATFORM_FILEMANAGERLISTJOB_H
 
 #include <KIO/Job>
+#include <QHash>
 #include <QQueue>
+#include <QSet>
+#include <QSharedPointer>
+
+#include <util/path.h>
 
 // uncomment to time imort jobs
 // #define TIME_IMPORT_JOB
@@ -34,12 +39,22 @@ namespace KDevelop
 {
     class ProjectFolderItem;
 
+/// The entries of a local folder together with its modification time at the time it was listed
+struct FolderListing
+{
+    qint64 lastModified = 0;
+    KIO::UDSEntryList entries;
+};
+
+using FolderListings = QHash<Path, FolderListing>;
+
 class FileManagerListJob : public KIO::Job
 {
     Q_OBJECT
 
 public:
     explicit FileManagerListJob(ProjectFolderItem* item);
+    ~FileManagerListJob() override;
     ProjectFolderItem* item() const;
 
     void addSubDir(ProjectFolderItem* item);
@@ -48,9 +63,28 @@ public:
     void abort();
     void start() override;
 
+    /**
+     * Use the given listings, e.g. from a previous session, instead of listing these folders again.
+     *
+     * The folders whose listings were used can be queried with restoredFolders() afterwards,
+     * it is up to the caller to check whether they are still up to date.
+     */
+    void setSnapshot(const FolderListings& snapshot);
+    /// @return the restored folders with the modification time they had when they were listed
+    QHash<Path, qint64> restoredFolders() const;
+
+    /**
+     * Set to false to only list the folders already in the project tree which got queued explicitly.
+     * Folders that get newly added to the tree are always listed recursively. Defaults to true.
+     */
+    void setRecursive(bool recursive);
+    bool isRecursive() const;
+
 Q_SIGNALS:
     void entries(FileManagerListJob* job, ProjectFolderItem* baseItem,
                  const KIO::UDSEntryList& entries);
+    /// emitted when a local folder has been listed
+    void listed(const KDevelop::Path& path, const KDevelop::FolderListing& listing);
     void nextJob();
 
 private Q_SLOTS:
@@ -58,15 +92,28 @@ private Q_SLOTS:
     void slotResult(KJob* job) override;
     void handleResults(const KIO::UDSEntryList& entries);
     void startNextJob();
+    void localListingDone(const KDevelop::Path& path, const KDevelop::FolderListing& listing);
 
 private:
+    /// Lists the local folder @p path in the thread pool, the result is passed to localListingDone()
+    void startLocalListing(const Path& path);
+    /// Starts listing the next queued local folders in the thread pool, ahead of their turn
+    void prefetchLocalFolders();
 
     QQueue<ProjectFolderItem*> m_listQueue;
+    /// local folders that are being listed or have been listed, but not handled yet
+    QSet<Path> m_prefetching;
+    QHash<Path, FolderListing> m_prefetched;
+    FolderListings m_snapshot;
+    QHash<Path, qint64> m_restored;
+    bool m_waitingForPrefetch = false;
+    bool m_recursive = true;
     /// current base dir
     ProjectFolderItem* m_item;
     KIO::UDSEntryList entryList;
-    // kill does not delete the job instantaniously
-    QAtomicInt m_aborted;
+    // kill does not delete the job instantaniously,
+    // shared with the listings in the thread pool which may outlive the job
+    QSharedPointer<QAtomicInt> m_aborted;
 
 #ifdef TIME_IMPORT_JOB
     QElapsedTimer m_timer;
@@ -77,4 +124,6 @@ private:
 
 }
 
+Q_DECLARE_METATYPE(KDevelop::FolderListing)
+
 #endif // KDEVPLATFORM_FILEMANAGERLISTJOB_H
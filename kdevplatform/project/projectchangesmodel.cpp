@@ -39,14 +39,23 @@
 
 #include <QDir>
 #include <QIcon>
+#include <QTimer>
 
 Q_DECLARE_METATYPE(KDevelop::IProject*)
 
 using namespace KDevelop;
 
+/// Maximal number of urls passed to a single status job, to keep the command line short
+static const int maxUrlsPerStatusJob = 100;
+
 ProjectChangesModel::ProjectChangesModel(QObject* parent)
     : VcsFileChangesModel(parent)
+    , m_updateTimer(new QTimer(this))
 {
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(100);
+    connect(m_updateTimer, &QTimer::timeout, this, &ProjectChangesModel::updatePendingChanges);
+
     foreach(IProject* p, ICore::self()->projectController()->projects())
         addProject(p);
     
@@ -97,6 +106,9 @@ void ProjectChangesModel::addProject(IProject* p)
 
 void ProjectChangesModel::removeProject(IProject* p)
 {
+    m_pendingProjects.remove(p);
+    m_pendingUrls.remove(p);
+
     QStandardItem* it=projectItem(p);
     
     removeRow(it->row());
@@ -142,6 +154,38 @@ void ProjectChangesModel::changes(IProject* project, const QList<QUrl>& urls, IB
     }
 }
 
+void ProjectChangesModel::scheduleChanges(IProject* project, const QList<QUrl>& urls, IBasicVersionControl::RecursionMode mode)
+{
+    if (mode == IBasicVersionControl::Recursive && urls == QList<QUrl>{project->path().toUrl()}) {
+        // a full update covers everything else requested for this project
+        m_pendingProjects.insert(project);
+        m_pendingUrls.remove(project);
+    } else if (mode == IBasicVersionControl::Recursive) {
+        changes(project, urls, mode);
+        return;
+    } else if (!m_pendingProjects.contains(project)) {
+        m_pendingUrls[project].unite(urls.toSet());
+    }
+
+    m_updateTimer->start();
+}
+
+void ProjectChangesModel::updatePendingChanges()
+{
+    foreach (IProject* project, m_pendingProjects) {
+        changes(project, {project->path().toUrl()}, IBasicVersionControl::Recursive);
+    }
+    m_pendingProjects.clear();
+
+    for (auto it = m_pendingUrls.constBegin(); it != m_pendingUrls.constEnd(); ++it) {
+        const QList<QUrl> urls = it.value().toList();
+        for (int i = 0; i < urls.size(); i += maxUrlsPerStatusJob) {
+            changes(it.key(), urls.mid(i, maxUrlsPerStatusJob), IBasicVersionControl::NonRecursive);
+        }
+    }
+    m_pendingUrls.clear();
+}
+
 void ProjectChangesModel::statusReady(KJob* job)
 {
     VcsJob* status=static_cast<VcsJob*>(job);
@@ -211,13 +255,13 @@ void ProjectChangesModel::itemsAdded(const QModelIndex& parent, int start, int e
     }
         
     if(!urls.isEmpty())
-        changes(project, urls, KDevelop::IBasicVersionControl::NonRecursive);
+        scheduleChanges(project, urls, KDevelop::IBasicVersionControl::NonRecursive);
 }
 
 void ProjectChangesModel::reload(const QList<IProject*>& projects)
 {
     foreach(IProject* project, projects)
-        changes(project, {project->path().toUrl()}, KDevelop::IBasicVersionControl::Recursive);
+        scheduleChanges(project, {project->path().toUrl()}, KDevelop::IBasicVersionControl::Recursive);
 }
 
 void ProjectChangesModel::reload(const QList<QUrl>& urls)
@@ -226,8 +270,7 @@ void ProjectChangesModel::reload(const QList<QUrl>& urls)
         IProject* project=ICore::self()->projectController()->findProjectForUrl(url);
         
         if (project) {
-            // FIXME: merge multiple urls of the same project
-            changes(project, {url}, KDevelop::IBasicVersionControl::NonRecursive);
+            scheduleChanges(project, {url}, KDevelop::IBasicVersionControl::NonRecursive);
         }
     }
 }
@@ -25,7 +25,11 @@
 
 #include "projectexport.h"
 
+#include <QHash>
+#include <QSet>
+
 class KJob;
+class QTimer;
 namespace KDevelop {
 class IProject;
 class IDocument;
@@ -57,8 +61,19 @@ class KDEVPLATFORMPROJECT_EXPORT ProjectChangesModel : public VcsFileChangesMode
         void repositoryBranchChanged(const QUrl& url);
         void branchNameReady(KDevelop::VcsJob* job);
 
+    private Q_SLOTS:
+        void updatePendingChanges();
+
     private:
         QStandardItem* projectItem(KDevelop::IProject* p) const;
+        /// Queue a status update, so that many requests in a row end up in few status jobs
+        void scheduleChanges(KDevelop::IProject* project, const QList<QUrl>& urls, KDevelop::IBasicVersionControl::RecursionMode mode);
+
+        QTimer* m_updateTimer;
+        /// Projects which need a recursive update of the whole project
+        QSet<KDevelop::IProject*> m_pendingProjects;
+        /// Urls which need a non-recursive update, by project
+        QHash<KDevelop::IProject*, QSet<QUrl>> m_pendingUrls;
 };
 
 }
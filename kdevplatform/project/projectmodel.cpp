@@ -100,7 +100,7 @@ public:
 class ProjectBaseItemPrivate
 {
 public:
-    ProjectBaseItemPrivate() : project(nullptr), parent(nullptr), row(-1), model(nullptr), m_pathIndex(0) {}
+    ProjectBaseItemPrivate() : project(nullptr), parent(nullptr), row(-1), model(nullptr), m_pathIndex(0), m_pathFromParent(false) {}
     IProject* project;
     ProjectBaseItem* parent;
     int row;
@@ -111,8 +111,30 @@ public:
     ProjectModel* model;
     Path m_path;
     uint m_pathIndex;
+    // When set, m_path is empty and the path is the parent folder's path plus the item's text.
+    // Most items are files, this way they don't need to store all segments of their path.
+    bool m_pathFromParent;
     QString iconName;
 
+    void sharePathWithParent()
+    {
+        if (m_pathFromParent || !parent || !parent->folder() || m_path.lastPathSegment() != text) {
+            return;
+        }
+        if (m_path.parent() == parent->path()) {
+            m_path = Path();
+            m_pathFromParent = true;
+        }
+    }
+
+    void detachPathFromParent(const ProjectBaseItem* item)
+    {
+        if (m_pathFromParent) {
+            m_path = item->path();
+            m_pathFromParent = false;
+        }
+    }
+
     ProjectBaseItem::RenameStatus renameBaseItem(ProjectBaseItem* item, const QString& newName)
     {
         if (item->parent()) {
@@ -213,6 +235,7 @@ ProjectBaseItem* ProjectBaseItem::takeRow(int row)
         model()->beginRemoveRows(index(), row, row);
     }
     ProjectBaseItem* olditem = d->children.takeAt( row );
+    olditem->d_func()->detachPathFromParent(olditem);
     olditem->d_func()->parent = nullptr;
     olditem->d_func()->row = -1;
     olditem->setModel( nullptr );
@@ -257,16 +280,16 @@ void ProjectBaseItem::removeRows(int row, int count)
         }
         d->children.clear();
     } else {
-        for (int i = row; i < count; ++i) {
-            ProjectBaseItem* item = d->children.at(i);
+        const QList<ProjectBaseItem*> removed = d->children.mid(row, count);
+        d->children.erase(d->children.begin() + row, d->children.begin() + row + count);
+        foreach(ProjectBaseItem* item, removed) {
             item->d_func()->parent = nullptr;
             item->d_func()->row = -1;
             item->setModel( nullptr );
-            delete d->children.takeAt( row );
+            delete item;
         }
         for(int i = row; i < d->children.size(); ++i) {
-            d->children.at(i)->d_func()->row--;
-            Q_ASSERT(child(i)->d_func()->row==i);
+            d->children.at(i)->d_func()->row = i;
         }
     }
 
@@ -358,6 +381,11 @@ void ProjectBaseItem::setText( const QString& text )
 {
     Q_ASSERT(!text.isEmpty() || !parent());
     Q_D(ProjectBaseItem);
+    if (text == d->text) {
+        return;
+    }
+    // the path must not change along with the text
+    d->detachPathFromParent(this);
     d->text = text;
     if( d->model ) {
         QModelIndex idx = index();
@@ -408,6 +436,10 @@ bool ProjectBaseItem::lessThan( const KDevelop::ProjectBaseItem* item ) const
 
 bool ProjectBaseItem::pathLessThan(ProjectBaseItem* item1, ProjectBaseItem* item2)
 {
+    // siblings sharing the path of their folder only differ in their last segment, no need to build the paths
+    if (item1->d_ptr->m_pathFromParent && item2->d_ptr->m_pathFromParent && item1->d_ptr->parent == item2->d_ptr->parent) {
+        return item1->d_ptr->text.compare(item2->d_ptr->text) < 0;
+    }
     return item1->path() < item2->path();
 }
 
@@ -447,6 +479,13 @@ void ProjectBaseItem::appendRow( ProjectBaseItem* item )
 Path ProjectBaseItem::path() const
 {
     Q_D(const ProjectBaseItem);
+    if (d->m_pathFromParent) {
+        if (d->parent) {
+            return Path(d->parent->path(), d->text);
+        }
+        // the item is being removed from its parent, fall back to the interned path
+        return Path(IndexedString::fromIndex(d->m_pathIndex).str());
+    }
     return d->m_path;
 }
 
@@ -464,6 +503,7 @@ void ProjectBaseItem::setPath( const Path& path)
     }
 
     d->m_path = path;
+    d->m_pathFromParent = false;
     d->m_pathIndex = indexForPath(path);
     setText( path.lastPathSegment() );
 
@@ -580,9 +620,10 @@ ProjectFolderItem::ProjectFolderItem(IProject* project, const Path& path, Projec
 {
     setPath( path );
 
-    setFlags(flags() | Qt::ItemIsDropEnabled);
+    // no need to emit dataChanged for the flags of a new item
+    d_ptr->flags |= Qt::ItemIsDropEnabled;
     if (project && project->path() != path)
-        setFlags(flags() | Qt::ItemIsDragEnabled);
+        d_ptr->flags |= Qt::ItemIsDragEnabled;
 }
 
 ProjectFolderItem::ProjectFolderItem( const QString & name, ProjectBaseItem * parent )
@@ -590,9 +631,9 @@ ProjectFolderItem::ProjectFolderItem( const QString & name, ProjectBaseItem * pa
 {
     setPath( Path(parent->path(), name) );
 
-    setFlags(flags() | Qt::ItemIsDropEnabled);
+    d_ptr->flags |= Qt::ItemIsDropEnabled;
     if (project() && project()->path() != path())
-        setFlags(flags() | Qt::ItemIsDragEnabled);
+        d_ptr->flags |= Qt::ItemIsDragEnabled;
 }
 
 ProjectFolderItem::~ProjectFolderItem()
@@ -689,14 +730,14 @@ QString ProjectBuildFolderItem::iconName() const
 ProjectFileItem::ProjectFileItem( IProject* project, const Path& path, ProjectBaseItem* parent )
     : ProjectBaseItem( project, path.lastPathSegment(), parent )
 {
-    setFlags(flags() | Qt::ItemIsDragEnabled);
+    d_ptr->flags |= Qt::ItemIsDragEnabled;
     setPath( path );
 }
 
 ProjectFileItem::ProjectFileItem( const QString& name, ProjectBaseItem* parent )
     : ProjectBaseItem( parent->project(), name, parent )
 {
-    setFlags(flags() | Qt::ItemIsDragEnabled);
+    d_ptr->flags |= Qt::ItemIsDragEnabled;
     setPath( Path(parent->path(), name) );
 }
 
@@ -740,7 +781,7 @@ bool isNumeric(const QStringRef& str)
 class IconNameCache
 {
 public:
-    QString iconNameForPath(const Path& path, const QString& fileName)
+    QString iconNameForFile(const QString& fileName)
     {
         // find icon name based on file extension, if possible
         QString extension;
@@ -761,7 +802,7 @@ public:
             }
         }
 
-        QMimeType mime = QMimeDatabase().mimeTypeForFile(path.lastPathSegment(), QMimeDatabase::MatchExtension); // no I/O
+        QMimeType mime = QMimeDatabase().mimeTypeForFile(fileName, QMimeDatabase::MatchExtension); // no I/O
         QMutexLocker lock(&mutex);
         QHash< QString, QString >::const_iterator it = mimeToIcon.constFind(mime.name());
         QString iconName;
@@ -791,7 +832,7 @@ QString ProjectFileItem::iconName() const
     // think of d_ptr->iconName as mutable, possible since d_ptr is not const
     if (d_ptr->iconName.isEmpty()) {
         // lazy load implementation of icon lookup
-        d_ptr->iconName = s_cache->iconNameForPath( d_ptr->m_path, d_ptr->text );
+        d_ptr->iconName = s_cache->iconNameForFile( d_ptr->text );
         // we should always get *some* icon name back
         Q_ASSERT(!d_ptr->iconName.isEmpty());
     }
@@ -800,7 +841,12 @@ QString ProjectFileItem::iconName() const
 
 void ProjectFileItem::setPath( const Path& path )
 {
-    if (path == d_ptr->m_path) {
+    // a path shared with the parent folder already reflects the folder's new path when it is renamed,
+    // so compare against the interned path instead
+    const bool unchanged = d_ptr->m_pathFromParent
+                         ? IndexedString::fromIndex(d_ptr->m_pathIndex).str() == path.pathOrUrl()
+                         : path == d_ptr->m_path;
+    if (unchanged) {
         return;
     }
 
@@ -811,6 +857,8 @@ void ProjectFileItem::setPath( const Path& path )
 
     ProjectBaseItem::setPath( path );
 
+    d_ptr->sharePathWithParent();
+
     if( project() && d_ptr->m_pathIndex ) {
         // add to fileset with new path
         project()->addToFileSet( this );
@@ -846,6 +894,7 @@ void ProjectTargetItem::setPath( const Path& path )
     // don't call base class, it calls setText with the new path's filename
     // which we do not want for target items
     d_ptr->m_path = path;
+    d_ptr->m_pathFromParent = false;
 }
 
 int ProjectTargetItem::type() const
@@ -990,12 +1039,19 @@ QVariant ProjectModel::data( const QModelIndex& index, int role ) const
                 case Qt::DecorationRole:
                     return QIcon::fromTheme(item->iconName());
                 case Qt::ToolTipRole:
+                    // the interned path of a file is there already, its Path would have to be built
+                    if (ProjectFileItem* file = item->file()) {
+                        return file->indexedPath().str();
+                    }
                     return item->path().pathOrUrl();
                 case Qt::DisplayRole:
                     return item->text();
                 case ProjectItemRole:
                     return QVariant::fromValue<ProjectBaseItem*>(item);
                 case UrlRole:
+                    if (ProjectFileItem* file = item->file()) {
+                        return file->indexedPath().toUrl();
+                    }
                     return item->path().toUrl();
                 case ProjectRole:
                     return QVariant::fromValue<QObject*>(item->project());
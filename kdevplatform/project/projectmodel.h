@@ -206,6 +206,9 @@ class KDEVPLATFORMPROJECT_EXPORT ProjectBaseItem
 
         /**
          * @returns the path of this item.
+         *
+         * The path of a file item is built from the path of its folder on each call.
+         * Use ProjectFileItem::indexedPath() where the interned path is enough, e.g. for lookups.
          */
         Path path() const;
 
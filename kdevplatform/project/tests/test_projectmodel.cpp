@@ -323,6 +323,59 @@ void TestProjectModel::testTakeRow()
     QCOMPARE( subchild->model(), static_cast<ProjectModel*>(nullptr) );
 }
 
+void TestProjectModel::testRemoveRows()
+{
+    ProjectBaseItem* parent = new ProjectBaseItem( nullptr, QStringLiteral("test") );
+    for (int i = 0; i < 6; ++i) {
+        new ProjectBaseItem( nullptr, QStringLiteral("child%1").arg(i), parent );
+    }
+    model->appendRow( parent );
+
+    parent->removeRows(1, 3);
+
+    QCOMPARE( parent->rowCount(), 3 );
+    QCOMPARE( parent->child(0)->text(), QStringLiteral("child0") );
+    QCOMPARE( parent->child(1)->text(), QStringLiteral("child4") );
+    QCOMPARE( parent->child(2)->text(), QStringLiteral("child5") );
+    for (int i = 0; i < parent->rowCount(); ++i) {
+        QCOMPARE( parent->child(i)->row(), i );
+    }
+}
+
+void TestProjectModel::testFilePathFromFolder()
+{
+    const Path folderPath(QStringLiteral("/tmp/folder"));
+    ProjectFolderItem* folder = new ProjectFolderItem( nullptr, folderPath );
+    ProjectFileItem* file = new ProjectFileItem( QStringLiteral("file.cpp"), folder );
+    model->appendRow( folder );
+
+    QCOMPARE( file->path(), Path(folderPath, QStringLiteral("file.cpp")) );
+    QCOMPARE( model->itemForPath(IndexedString(file->path().pathOrUrl())), static_cast<ProjectBaseItem*>(file) );
+    QCOMPARE( file->index().data(Qt::ToolTipRole).toString(), file->path().pathOrUrl() );
+    QCOMPARE( file->index().data(ProjectModel::UrlRole).toUrl(), file->path().toUrl() );
+
+    // siblings are ordered by name like their paths are
+    ProjectFileItem* sibling = new ProjectFileItem( QStringLiteral("File.cpp"), folder );
+    QCOMPARE( ProjectBaseItem::pathLessThan(file, sibling), file->path() < sibling->path() );
+    QCOMPARE( ProjectBaseItem::pathLessThan(sibling, file), sibling->path() < file->path() );
+    delete sibling;
+
+    // the file follows a renamed folder
+    const Path newFolderPath(QStringLiteral("/tmp/otherfolder"));
+    folder->setPath( newFolderPath );
+    QCOMPARE( file->path(), Path(newFolderPath, QStringLiteral("file.cpp")) );
+    QCOMPARE( file->indexedPath(), IndexedString(file->path().pathOrUrl()) );
+    QCOMPARE( model->itemForPath(IndexedString(file->path().pathOrUrl())), static_cast<ProjectBaseItem*>(file) );
+
+    // and keeps its path when moved somewhere else
+    folder->takeRow( file->row() );
+    QCOMPARE( file->path(), Path(newFolderPath, QStringLiteral("file.cpp")) );
+    ProjectFolderItem* otherFolder = new ProjectFolderItem( nullptr, Path(QStringLiteral("/tmp/third")) );
+    otherFolder->appendRow( file );
+    QCOMPARE( file->path(), Path(newFolderPath, QStringLiteral("file.cpp")) );
+    delete otherFolder;
+}
+
 void TestProjectModel::testRename()
 {
     QFETCH( int, itemType );
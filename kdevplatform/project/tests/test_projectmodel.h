@@ -49,6 +49,8 @@ private Q_SLOTS:
     void testChangeWithProxyModel();
     void testWithProject();
     void testTakeRow();
+    void testRemoveRows();
+    void testFilePathFromFolder();
     void testItemsForPath();
     void testItemsForPath_data();
     void testProjectProxyModel();
@@ -47,6 +47,7 @@
 #include "workingsetcontroller.h"
 #include "testcontroller.h"
 #include "runtimecontroller.h"
+#include "startuptimeline.h"
 #include "debug.h"
 
 #include <KTextEditor/Document>
@@ -87,6 +88,15 @@ void installSignalHandler()
     std::signal(SIGTERM, shutdownGracefully);
 #endif
 }
+
+/// run @p initialize as a step of the startup timeline
+template<typename F>
+void startupStep(const char* name, F initialize)
+{
+    KDevelop::StartupTimeline::Step step(QString::fromLatin1(name));
+    initialize();
+}
+
 }
 
 namespace KDevelop {
@@ -151,7 +161,8 @@ bool CorePrivate::initialize(Core::Setup mode, QString session )
 
     if( !pluginController )
     {
-        pluginController = new PluginController(m_core);
+        // finds the plugins and reads their metadata
+        startupStep("creating PluginController", [this] { pluginController = new PluginController(m_core); });
         const auto pluginInfos = pluginController->allPluginInfos();
         if (pluginInfos.isEmpty()) {
             QMessageBox::critical(nullptr,
@@ -230,24 +241,24 @@ bool CorePrivate::initialize(Core::Setup mode, QString session )
 
     qCDebug(SHELL) << "Initializing controllers";
 
-    sessionController.data()->initialize( session );
+    startupStep("SessionController", [&] { sessionController.data()->initialize( session ); });
     if( !sessionController.data()->activeSessionLock() ) {
         return false;
     }
 
     // TODO: Is this early enough, or should we put the loading of the session into
     // the controller construct
-    DUChain::initialize();
+    startupStep("DUChain", [] { DUChain::initialize(); });
 
     if (!(mode & Core::NoUi)) {
-        uiController.data()->initialize();
+        startupStep("UiController", [this] { uiController.data()->initialize(); });
     }
-    languageController.data()->initialize();
+    startupStep("LanguageController", [this] { languageController.data()->initialize(); });
     if (partController) {
-        partController.data()->initialize();
+        startupStep("PartController", [this] { partController.data()->initialize(); });
     }
-    projectController.data()->initialize();
-    documentController.data()->initialize();
+    startupStep("ProjectController", [this] { projectController.data()->initialize(); });
+    startupStep("DocumentController", [this] { documentController.data()->initialize(); });
 
     /* This is somewhat messy.  We want to load the areas before
         loading the plugins, so that when each plugin is loaded we
@@ -259,29 +270,29 @@ bool CorePrivate::initialize(Core::Setup mode, QString session )
         those tool views when loading an area.  */
 
     qCDebug(SHELL) << "Initializing plugin controller (loading session plugins)";
-    pluginController.data()->initialize();
+    startupStep("PluginController", [this] { pluginController.data()->initialize(); });
 
     qCDebug(SHELL) << "Initializing working set controller";
     if(!(mode & Core::NoUi))
     {
-        workingSetController.data()->initialize();
+        startupStep("WorkingSetController", [this] { workingSetController.data()->initialize(); });
         /* Need to do this after everything else is loaded.  It's too
             hard to restore position of views, and toolbars, and whatever
             that are not created yet.  */
-        uiController.data()->loadAllAreas(KSharedConfig::openConfig());
-        uiController.data()->defaultMainWindow()->show();
+        startupStep("loading areas", [this] { uiController.data()->loadAllAreas(KSharedConfig::openConfig()); });
+        startupStep("showing main window", [this] { uiController.data()->defaultMainWindow()->show(); });
     }
 
     qCDebug(SHELL) << "Initializing remaining controllers";
-    runController.data()->initialize();
-    sourceFormatterController.data()->initialize();
-    selectionController.data()->initialize();
+    startupStep("RunController", [this] { runController.data()->initialize(); });
+    startupStep("SourceFormatterController", [this] { sourceFormatterController.data()->initialize(); });
+    startupStep("SelectionController", [this] { selectionController.data()->initialize(); });
     if (documentationController) {
-        documentationController.data()->initialize();
+        startupStep("DocumentationController", [this] { documentationController.data()->initialize(); });
     }
-    debugController.data()->initialize();
-    testController.data()->initialize();
-    runtimeController.data()->initialize();
+    startupStep("DebugController", [this] { debugController.data()->initialize(); });
+    startupStep("TestController", [this] { testController.data()->initialize(); });
+    startupStep("RuntimeController", [this] { runtimeController.data()->initialize(); });
 
     installSignalHandler();
 
@@ -337,12 +348,16 @@ bool Core::initialize(Setup mode, const QString& session)
     if (m_self)
         return true;
 
+    StartupTimeline::begin();
+
     m_self = new Core();
     bool ret = m_self->d->initialize(mode, session);
 
     if(ret)
         emit m_self->initializationCompleted();
 
+    StartupTimeline::finish();
+
     return ret;
 }
 
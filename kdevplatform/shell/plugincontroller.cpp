@@ -25,6 +25,7 @@ Boston, MA 02110-1301, USA.
 
 #include <QElapsedTimer>
 #include <QMap>
+#include <QTimer>
 
 #include <KConfigGroup>
 #include <KLocalizedString>
@@ -46,6 +47,7 @@ Boston, MA 02110-1301, USA.
 #include "sourceformattercontroller.h"
 #include "projectcontroller.h"
 #include "ktexteditorpluginintegration.h"
+#include "startuptimeline.h"
 #include "debug.h"
 
 namespace {
@@ -60,6 +62,7 @@ inline QString KEY_Version() { return QStringLiteral("X-KDevelop-Version"); }
 inline QString KEY_Interfaces() { return QStringLiteral("X-KDevelop-Interfaces"); }
 inline QString KEY_Required() { return QStringLiteral("X-KDevelop-IRequired"); }
 inline QString KEY_Optional() { return QStringLiteral("X-KDevelop-IOptional"); }
+inline QString KEY_Deferred() { return QStringLiteral("X-KDevelop-Deferred"); }
 
 inline QString KEY_Global() { return QStringLiteral("Global"); }
 inline QString KEY_Project() { return QStringLiteral("Project"); }
@@ -78,6 +81,11 @@ bool isGlobalPlugin( const KPluginMetaData& info )
     return info.value(KEY_Category()) == KEY_Global();
 }
 
+bool isDeferred( const KPluginMetaData& info )
+{
+    return info.rawData().value(KEY_Deferred()).toBool();
+}
+
 bool hasMandatoryProperties( const KPluginMetaData& info )
 {
     QString mode = info.value(KEY_Mode());
@@ -162,6 +170,9 @@ public:
     };
     CleanupMode cleanupMode;
 
+    // global plugins which get loaded one by one after the startup, unless they are used earlier
+    QStringList deferredPlugins;
+
     bool canUnload(const KPluginMetaData& plugin)
     {
         qCDebug(SHELL) << "checking can unload for:" << plugin.name() << plugin.value(KEY_LoadMode());
@@ -330,6 +341,7 @@ void PluginController::cleanup()
     }
 
     d->cleanupMode = PluginControllerPrivate::CleaningUp;
+    d->deferredPlugins.clear();
 
     // Ask all plugins to unload
     while ( !d->loadedPlugins.isEmpty() )
@@ -387,6 +399,10 @@ void PluginController::initialize()
         }
     }
 
+    // without a UI there is nothing that could come up earlier, e.g. in unit tests
+    const bool hasUi = !(Core::self()->setupFlags() & Core::NoUi);
+
+    QVector<KPluginMetaData> startupPlugins;
     foreach( const KPluginMetaData& pi, d->plugins )
     {
         if( isGlobalPlugin( pi ) )
@@ -395,7 +411,11 @@ void PluginController::initialize()
             if( it != pluginMap.constEnd() && ( it.value() || !isUserSelectable( pi ) ) )
             {
                 // Plugin is mentioned in pluginmap and the value is true, so try to load it
-                loadPluginInternal( pi.pluginId() );
+                if (hasUi && isDeferred(pi)) {
+                    d->deferredPlugins << pi.pluginId();
+                } else {
+                    startupPlugins << pi;
+                }
                 if(!grp.hasKey(pi.pluginId() + KEY_Suffix_Enabled())) {
                     if( isUserSelectable( pi ) )
                     {
@@ -413,9 +433,32 @@ void PluginController::initialize()
     // Synchronize so we're writing out to the file.
     grp.sync();
 
+    for (const auto& info : startupPlugins) {
+        loadPluginInternal(info.pluginId());
+    }
+
+    if (!d->deferredPlugins.isEmpty()) {
+        qCDebug(SHELL) << "Deferring the loading of" << d->deferredPlugins;
+        QTimer::singleShot(0, this, &PluginController::loadDeferredPlugins);
+    }
+
     qCDebug(SHELL) << "Done loading plugins - took:" << timer.elapsed() << "ms";
 }
 
+void PluginController::loadDeferredPlugins()
+{
+    if (d->cleanupMode != PluginControllerPrivate::Running || d->deferredPlugins.isEmpty()) {
+        return;
+    }
+
+    // load one plugin per event loop iteration to keep the UI responsive
+    loadPluginInternal(d->deferredPlugins.takeFirst());
+
+    if (!d->deferredPlugins.isEmpty()) {
+        QTimer::singleShot(0, this, &PluginController::loadDeferredPlugins);
+    }
+}
+
 QList<IPlugin *> PluginController::loadedPlugins() const
 {
     return d->loadedPlugins.values();
@@ -490,6 +533,8 @@ IPlugin *PluginController::loadPluginInternal( const QString &pluginId )
         return plugin;
     }
 
+    StartupTimeline::Step step(pluginId);
+
     if ( !isEnabled( info ) ) {
         // Do not load disabled plugins
         qCWarning(SHELL) << "Not loading plugin named" << pluginId << "because it has been disabled!";
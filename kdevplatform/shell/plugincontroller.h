@@ -172,6 +172,12 @@ private:
     void cleanup();
     virtual void initialize();
 
+    /**
+     * Load the next plugin that was deferred on startup, and schedule
+     * the one after it for the next event loop iteration.
+     */
+    void loadDeferredPlugins();
+
 private:
     const QScopedPointer<class PluginControllerPrivate> d;
 };
@@ -1242,4 +1242,10 @@ void ProjectController::reparseProject( IProject* project, bool forceUpdate )
     ICore::self()->runController()->registerJob(d->m_parseJobs[project]);
 }
 
+void ProjectController::reparseFiles( IProject* project, const QSet<IndexedString>& files, bool forceUpdate )
+{
+    // leave the parse job of the project alone, it may not have queued all of its files yet
+    ICore::self()->runController()->registerJob(new KDevelop::ParseProjectJob(project, files, forceUpdate));
+}
+
 }
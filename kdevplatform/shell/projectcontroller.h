@@ -110,6 +110,7 @@ public Q_SLOTS:
     void configureProject( IProject* ) override;
 
     void reparseProject( IProject* project, bool forceUpdate = false  ) override;
+    void reparseFiles( IProject* project, const QSet<IndexedString>& files, bool forceUpdate = false ) override;
 
     void eventuallyOpenProjectFile(KIO::Job*,KIO::UDSEntryList);
     void openProjectForUrlSlot(bool);
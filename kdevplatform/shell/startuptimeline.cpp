@@ -0,0 +1,117 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) version 3, or any
+ * later version accepted by the membership of KDE e.V. (or its
+ * successor approved by the membership of KDE e.V.), which shall
+ * act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "startuptimeline.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+
+#include "debug.h"
+
+using namespace KDevelop;
+
+namespace {
+
+struct TimelineStep
+{
+    QString name;
+    qint64 start;
+    qint64 duration;
+    int depth;
+};
+
+struct Timeline
+{
+    bool recording = false;
+    int depth = 0;
+    QElapsedTimer clock;
+    QVector<TimelineStep> steps;
+};
+
+Q_GLOBAL_STATIC(Timeline, timeline)
+
+}
+
+StartupTimeline::Step::Step(const QString& name)
+    : m_name(name)
+    , m_start(timeline->recording ? timeline->clock.elapsed() : -1)
+{
+    if (m_start >= 0) {
+        ++timeline->depth;
+    }
+}
+
+StartupTimeline::Step::~Step()
+{
+    if (m_start < 0 || !timeline->recording) {
+        return;
+    }
+    --timeline->depth;
+    timeline->steps.append({m_name, m_start, timeline->clock.elapsed() - m_start, timeline->depth});
+}
+
+void StartupTimeline::begin()
+{
+    timeline->recording = true;
+    timeline->depth = 0;
+    timeline->steps.clear();
+    timeline->clock.start();
+}
+
+void StartupTimeline::finish()
+{
+    if (!timeline->recording) {
+        return;
+    }
+    timeline->recording = false;
+
+    // steps are recorded when they end, i.e. nested steps before the outer ones
+    auto steps = timeline->steps;
+    std::sort(steps.begin(), steps.end(), [](const TimelineStep& lhs, const TimelineStep& rhs) {
+        return lhs.start < rhs.start || (lhs.start == rhs.start && lhs.depth < rhs.depth);
+    });
+
+    QString output;
+    QTextStream stream(&output);
+    stream << "startup took " << timeline->clock.elapsed() << " ms\n";
+    stream << "start [ms]\tduration [ms]\tstep\n";
+    for (const auto& step : steps) {
+        stream << step.start << '\t' << step.duration << '\t' << QString(step.depth * 2, QLatin1Char(' ')) << step.name << '\n';
+    }
+    stream.flush();
+
+    qCDebug(SHELL).noquote() << output;
+
+    const QString fileName = QString::fromLocal8Bit(qgetenv("KDEV_STARTUP_TIMELINE"));
+    if (!fileName.isEmpty()) {
+        QFile file(fileName);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            file.write(output.toUtf8());
+        } else {
+            qCWarning(SHELL) << "Failed to write the startup timeline to" << fileName << file.errorString();
+        }
+    }
+    timeline->steps.clear();
+}
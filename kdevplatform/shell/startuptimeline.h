@@ -0,0 +1,66 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) version 3, or any
+ * later version accepted by the membership of KDE e.V. (or its
+ * successor approved by the membership of KDE e.V.), which shall
+ * act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef KDEVPLATFORM_STARTUPTIMELINE_H
+#define KDEVPLATFORM_STARTUPTIMELINE_H
+
+#include <QString>
+
+namespace KDevelop {
+
+/**
+ * Records how long the steps of the startup take, i.e. the initialization
+ * of the controllers and the loading of the plugins.
+ *
+ * The timeline is written to the debug output when the startup has finished.
+ * If KDEV_STARTUP_TIMELINE is set to a file name, it is written to that file, too.
+ *
+ * Only use this from the main thread.
+ */
+class StartupTimeline
+{
+public:
+    /**
+     * Times a step from construction to destruction.
+     *
+     * Steps can be nested, e.g. the dependencies loaded while loading a plugin.
+     * Nothing is recorded when no startup is in progress.
+     */
+    class Step
+    {
+    public:
+        explicit Step(const QString& name);
+        ~Step();
+
+    private:
+        Q_DISABLE_COPY(Step)
+
+        const QString m_name;
+        const qint64 m_start;
+    };
+
+    static void begin();
+    static void finish();
+};
+
+}
+
+#endif
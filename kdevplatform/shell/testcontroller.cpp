@@ -78,9 +78,9 @@ void TestController::addTestSuite(ITestSuite* suite)
 
 ITestSuite* TestController::findTestSuite(IProject* project, const QString& name) const
 {
-    foreach (ITestSuite* suite, testSuitesForProject(project))
+    foreach (ITestSuite* suite, d->suites)
     {
-        if (suite->name() == name)
+        if (suite->project() == project && suite->name() == name)
         {
             return suite;
         }
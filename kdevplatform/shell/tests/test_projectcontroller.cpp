@@ -29,7 +29,9 @@
 #include <tests/autotestshell.h>
 #include <tests/testcore.h>
 
+#include <interfaces/ilanguagecontroller.h>
 #include <interfaces/iplugin.h>
+#include <language/backgroundparser/backgroundparser.h>
 #include <project/interfaces/iprojectfilemanager.h>
 #include <project/projectmodel.h>
 #include <shell/core.h>
@@ -477,6 +479,45 @@ void TestProjectController::fileInSubdirectory()
     ASSERT_SINGLE_FILE_IN(sub,"zoo",filePath,file);
 }
 
+void TestProjectController::reparseFilesWhileParsing()
+{
+    // reparsing a few files, e.g. after a build system reload, must not
+    // drop the files the parse of the whole project didn't get to yet
+
+    m_projCtrl->openProject(m_projFilePath.toUrl());
+    WAIT_FOR_OPEN_SIGNAL;
+    Project* proj;
+    assertProjectOpened(m_projName, (KDevelop::IProject*&)proj);
+
+    FakeFileManager* fileMng = createFileManager();
+    const Path a(m_projFolder, QStringLiteral("a.cpp"));
+    const Path b(m_projFolder, QStringLiteral("b.cpp"));
+    const Path c(m_projFolder, QStringLiteral("c.cpp"));
+    for (const Path& file : {a, b, c}) {
+        fileMng->addFileToFolder(m_projFolder, file);
+    }
+    proj->setManagerPlugin(fileMng);
+    proj->reloadModel();
+    QTest::qWait(100);
+    QCOMPARE(proj->fileSet().size(), 3);
+
+    auto backgroundParser = m_core->languageController()->backgroundParser();
+    backgroundParser->suspend();
+
+    m_projCtrl->reparseProject(proj);
+    m_projCtrl->reparseFiles(proj, {IndexedString(a.toUrl())}, true);
+    // a second reload right after the first one
+    m_projCtrl->reparseFiles(proj, {IndexedString(b.toUrl())}, true);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    for (const Path& file : {a, b, c}) {
+        QVERIFY(backgroundParser->isQueued(IndexedString(file.toUrl())));
+    }
+
+    m_projCtrl->closeProject(proj);
+    backgroundParser->resume();
+}
+
 void TestProjectController::prettyFileName_data()
 {
     QTest::addColumn<QString>("relativeFilePath");
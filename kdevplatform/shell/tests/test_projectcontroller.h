@@ -55,6 +55,7 @@ private Q_SLOTS:
     void singleFile();
     void singleDirectory();
     void fileInSubdirectory();
+    void reparseFilesWhileParsing();
     void prettyFileName_data();
     void prettyFileName();
 
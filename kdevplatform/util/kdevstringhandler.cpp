@@ -73,6 +73,8 @@
 #include <QRegExp>
 #include <QTextDocument>
 
+#include <algorithm>
+
 namespace KDevelop
 {
     QString joinWithEscaping( const QStringList& input, const QChar& joinchar, const QChar& escapechar )
@@ -173,6 +175,14 @@ QString KDevelop::stripAnsiSequences(const QString& str)
         return QString(); // fast path
     }
 
+    // most lines do not contain any escape sequence, share them instead of copying
+    const bool hasEscape = std::any_of(str.constBegin(), str.constEnd(), [](QChar c) {
+        return c.unicode() == 27 || c.unicode() == 155;
+    });
+    if (!hasEscape) {
+        return str;
+    }
+
     enum {
         PLAIN,
         ANSI_START,
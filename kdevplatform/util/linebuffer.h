@@ -0,0 +1,131 @@
+/*
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License version 2 as published by the Free Software Foundation.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDEVPLATFORM_LINEBUFFER_H
+#define KDEVPLATFORM_LINEBUFFER_H
+
+#include <QByteArray>
+
+#include <cstring>
+
+namespace KDevelop {
+
+/**
+ * Splits a stream of bytes, e.g. the output of a process, into lines.
+ *
+ * Taking a line only advances a read position, the consumed data is dropped
+ * once all complete lines have been taken. Also, the data is scanned for line
+ * breaks only once, even if a long line arrives in many small chunks.
+ * So the cost of splitting stays linear in the size of the data, no matter
+ * how many lines arrive in one go.
+ *
+ * The line break itself is not part of the returned lines, a trailing
+ * carriage return is kept.
+ */
+class LineBuffer
+{
+public:
+    void append(const QByteArray& data)
+    {
+        if (m_begin == m_data.size()) {
+            // everything has been consumed, share the new data instead of copying it
+            m_data = data;
+            m_begin = 0;
+            m_scanned = 0;
+        } else {
+            m_data += data;
+        }
+    }
+
+    /**
+     * Take the next complete line out of the buffer.
+     *
+     * @return false if there is no complete line left.
+     */
+    bool takeLine(QByteArray* line)
+    {
+        int length;
+        const char* begin = nextLine(&length);
+        if (!begin) {
+            return false;
+        }
+        *line = QByteArray(begin, length);
+        return true;
+    }
+
+    /**
+     * Take the next complete line out of the buffer without copying it.
+     *
+     * @return the start of the line, or nullptr if there is no complete line left.
+     *         The data stays valid until the next call to any method of the buffer.
+     */
+    const char* nextLine(int* length)
+    {
+        const int size = m_data.size();
+        const char* data = m_data.constData();
+        auto end = static_cast<const char*>(memchr(data + m_scanned, '\n', size - m_scanned));
+        if (!end) {
+            m_scanned = size;
+            compact();
+            return nullptr;
+        }
+
+        const char* begin = data + m_begin;
+        *length = end - begin;
+        m_begin = m_scanned = end - data + 1;
+        return begin;
+    }
+
+    bool isEmpty() const
+    {
+        return m_begin == m_data.size();
+    }
+
+    /// @return the data of an incomplete last line and clear the buffer
+    QByteArray takeAll()
+    {
+        const QByteArray rest = m_data.mid(m_begin);
+        clear();
+        return rest;
+    }
+
+    void clear()
+    {
+        m_data.clear();
+        m_begin = 0;
+        m_scanned = 0;
+    }
+
+private:
+    void compact()
+    {
+        if (m_begin > 0) {
+            m_data.remove(0, m_begin);
+            m_scanned -= m_begin;
+            m_begin = 0;
+        }
+    }
+
+    QByteArray m_data;
+    /// Start of the data that has not been taken yet
+    int m_begin = 0;
+    /// Everything before this offset is known not to contain a line break
+    int m_scanned = 0;
+};
+
+}
+
+#endif
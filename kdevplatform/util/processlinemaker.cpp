@@ -20,6 +20,7 @@
 */
 
 #include "processlinemaker.h"
+#include "linebuffer.h"
 
 #include <QProcess>
 #include <QStringList>
@@ -30,8 +31,8 @@ namespace KDevelop
 class ProcessLineMakerPrivate
 {
 public:
-    QByteArray stdoutbuf;
-    QByteArray stderrbuf;
+    LineBuffer stdoutbuf;
+    LineBuffer stderrbuf;
     ProcessLineMaker* p;
     QProcess* m_proc;
 
@@ -42,20 +43,18 @@ public:
 
     void slotReadyReadStdout()
     {
-        stdoutbuf += m_proc->readAllStandardOutput();
+        stdoutbuf.append(m_proc->readAllStandardOutput());
         processStdOut();
     }
 
-    static QStringList streamToStrings(QByteArray &data)
+    static QStringList streamToStrings(LineBuffer& data)
     {
         QStringList lineList;
-        int pos;
-        while ( (pos = data.indexOf('\n')) != -1) {
-            if (pos > 0 && data.at(pos - 1) == '\r')
-                lineList << QString::fromLocal8Bit(data, pos - 1);
-            else
-                lineList << QString::fromLocal8Bit(data, pos);
-            data.remove(0, pos+1);
+        int length;
+        while (const char* line = data.nextLine(&length)) {
+            if (length > 0 && line[length - 1] == '\r')
+                --length;
+            lineList << QString::fromLocal8Bit(line, length);
         }
         return lineList;
     }
@@ -67,7 +66,7 @@ public:
 
     void slotReadyReadStderr()
     {
-        stderrbuf += m_proc->readAllStandardError();
+        stderrbuf.append(m_proc->readAllStandardError());
         processStdErr();
     }
 
@@ -99,28 +98,28 @@ ProcessLineMaker::~ProcessLineMaker() = default;
 
 void ProcessLineMaker::slotReceivedStdout( const QByteArray& buffer )
 {
-    d->stdoutbuf += buffer;
+    d->stdoutbuf.append(buffer);
     d->processStdOut();
 }
 
 void ProcessLineMaker::slotReceivedStderr( const QByteArray& buffer )
 {
-    d->stderrbuf += buffer;
+    d->stderrbuf.append(buffer);
     d->processStdErr();
 }
 
 void ProcessLineMaker::discardBuffers( )
 {
-    d->stderrbuf.truncate(0);
-    d->stdoutbuf.truncate(0);
+    d->stderrbuf.clear();
+    d->stdoutbuf.clear();
 }
 
 void ProcessLineMaker::flushBuffers()
 {
     if (!d->stdoutbuf.isEmpty())
-        emit receivedStdoutLines(QStringList(QString::fromLocal8Bit(d->stdoutbuf)));
+        emit receivedStdoutLines(QStringList(QString::fromLocal8Bit(d->stdoutbuf.takeAll())));
     if (!d->stderrbuf.isEmpty())
-        emit receivedStderrLines(QStringList(QString::fromLocal8Bit(d->stderrbuf)));
+        emit receivedStderrLines(QStringList(QString::fromLocal8Bit(d->stderrbuf.takeAll())));
     discardBuffers();
 }
 
@@ -0,0 +1,74 @@
+/*
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License version 2 as published by the Free Software Foundation.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+*/
+
+#include <QObject>
+#include <QTest>
+
+#include "../linebuffer.h"
+
+using namespace KDevelop;
+
+class TestLineBuffer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSplit()
+    {
+        LineBuffer buffer;
+        buffer.append("first\nsec");
+
+        QByteArray line;
+        QVERIFY(buffer.takeLine(&line));
+        QCOMPARE(line, QByteArray("first"));
+        QVERIFY(!buffer.takeLine(&line));
+        QVERIFY(!buffer.isEmpty());
+
+        buffer.append("ond\r\n\nthi");
+        QVERIFY(buffer.takeLine(&line));
+        QCOMPARE(line, QByteArray("second\r"));
+        QVERIFY(buffer.takeLine(&line));
+        QCOMPARE(line, QByteArray());
+        QVERIFY(!buffer.takeLine(&line));
+
+        QCOMPARE(buffer.takeAll(), QByteArray("thi"));
+        QVERIFY(buffer.isEmpty());
+        QVERIFY(!buffer.takeLine(&line));
+    }
+
+    void benchBurst()
+    {
+        QByteArray data;
+        for (int i = 0; i < 100000; ++i) {
+            data += "^done,value=\"some reply of the debugger\"\n";
+        }
+
+        QBENCHMARK {
+            LineBuffer buffer;
+            buffer.append(data);
+            int lines = 0;
+            int length;
+            while (buffer.nextLine(&length)) {
+                ++lines;
+            }
+            QCOMPARE(lines, 100000);
+        }
+    }
+};
+
+QTEST_MAIN(TestLineBuffer)
+
+#include "test_linebuffer.moc"
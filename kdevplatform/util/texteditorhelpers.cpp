@@ -21,6 +21,7 @@
 
 #include "texteditorhelpers.h"
 
+#include <KTextEditor/Document>
 #include <KTextEditor/View>
 
 #include <QRegularExpression>
@@ -51,6 +52,16 @@ QRect KTextEditorHelpers::getItemBoundingRect(const KTextEditor::View* view, con
   return QRect(startPoint, endPoint);
 }
 
+KTextEditor::Range KTextEditorHelpers::visibleLines(const KTextEditor::View* view)
+{
+  // Probe the middle of the view, the borders at the left are not part of the text area
+  const KTextEditor::Cursor top = view->coordinatesToCursor(QPoint(view->width() / 2, 0));
+  const KTextEditor::Cursor bottom = view->coordinatesToCursor(QPoint(view->width() / 2, view->height() - 1));
+  const int first = top.isValid() ? top.line() : view->cursorPosition().line();
+  const int last = bottom.isValid() ? bottom.line() : view->document()->lines() - 1;
+  return KTextEditor::Range(first, 0, qMax(first, last), 0);
+}
+
 KTextEditor::Cursor KTextEditorHelpers::extractCursor(const QString& input, int* pathLength)
 {
     // ":ll:cc", ":ll"
@@ -36,6 +36,13 @@ namespace KTextEditorHelpers {
 /// @return Item's bounding rect in global screen coordinates
 QRect KDEVPLATFORMUTIL_EXPORT getItemBoundingRect(const KTextEditor::View* view, const KTextEditor::Range& itemRange);
 
+/**
+ * @return The lines shown in @p view, as a range from the start of the first to the start of the last visible line
+ *
+ * This is an estimate, meant to prioritize work on the visible region of big documents.
+ */
+KTextEditor::Range KDEVPLATFORMUTIL_EXPORT visibleLines(const KTextEditor::View* view);
+
 /**
  * @brief Try parsing a string such as "path_to_file:line_num:column_num".
  *
@@ -278,6 +278,8 @@ void DVcsJob::slotReceivedStdout()
     d->output.append(output);
 
     displayOutput(QString::fromLocal8Bit(output));
+
+    emit receivedStdout(output);
 }
 
 VcsJob::JobStatus DVcsJob::status() const
@@ -209,6 +209,14 @@ public Q_SLOTS:
 Q_SIGNALS:
     void readyForParsing(KDevelop::DVcsJob *job);
 
+    /**
+     * Emitted whenever the process wrote to its standard output.
+     *
+     * @p output only contains the newly received data, which allows
+     * parsing long outputs while the process is still running.
+     */
+    void receivedStdout(const QByteArray& output);
+
 protected Q_SLOTS:
     virtual void slotProcessError( QProcess::ProcessError );
 
@@ -25,6 +25,7 @@
 #include <QDateTime>
 #include <QList>
 #include <QLocale>
+#include <QTimer>
 
 #include <KLocalizedString>
 
@@ -69,7 +70,7 @@ QVariant VcsBasicEventModel::data(const QModelIndex& idx, int role) const
     if( idx.row() < 0 || idx.row() >= rowCount() || idx.column() < 0 || idx.column() >= columnCount() )
         return QVariant();
 
-    KDevelop::VcsEvent ev = d->m_events.at( idx.row() );
+    const KDevelop::VcsEvent& ev = d->m_events.at( idx.row() );
     switch( idx.column() )
     {
         case RevisionColumn:
@@ -134,8 +135,18 @@ public:
     QUrl m_url;
     bool done;
     bool fetching;
+    /// True if the first event of the running log job is already in the model
+    bool skipFirst = false;
+    /// Number of events the running log job added to the model
+    int jobEvents = 0;
 };
 
+namespace {
+/// Pages grow with the model, but stay small enough to keep git responsive
+const int minPageSize = 100;
+const int maxPageSize = 1000;
+}
+
 VcsEventLogModel::VcsEventLogModel(KDevelop::IBasicVersionControl* iface, const VcsRevision& rev, const QUrl& url, QObject* parent)
     : KDevelop::VcsBasicEventModel(parent), d(new VcsEventLogModelPrivate)
 {
@@ -158,34 +169,48 @@ void VcsEventLogModel::fetchMore(const QModelIndex& parent)
     d->fetching = true;
     Q_ASSERT(!parent.isValid());
     Q_UNUSED(parent);
-    VcsJob* job = d->m_iface->log(d->m_url, d->m_rev, qMax(rowCount(), 100));
+
+    // the next page starts at the last revision we already have
+    d->skipFirst = rowCount() > 0;
+    d->jobEvents = 0;
+    const int pageSize = qBound(minPageSize, rowCount(), maxPageSize);
+    VcsJob* job = d->m_iface->log(d->m_url, d->m_rev, d->skipFirst ? pageSize + 1 : pageSize);
     connect(this, &VcsEventLogModel::destroyed, job, [job] { job->kill(); });
-    connect(job, &VcsJob::finished, this, &VcsEventLogModel::jobReceivedResults);
+    connect(job, &VcsJob::resultsReady, this, &VcsEventLogModel::jobReceivedResults);
+    connect(job, &VcsJob::finished, this, &VcsEventLogModel::jobFinished);
     ICore::self()->runController()->registerJob( job );
 }
 
-void VcsEventLogModel::jobReceivedResults(KJob* job)
+void VcsEventLogModel::jobReceivedResults(KDevelop::VcsJob* job)
 {
-    QList<QVariant> l = qobject_cast<KDevelop::VcsJob *>(job)->fetchResults().toList();
-    if(l.isEmpty() || job->error()!=0) {
-        d->done = true;
-        return;
-    }
     QList<KDevelop::VcsEvent> newevents;
-    foreach( const QVariant &v, l )
+    foreach( const QVariant &v, job->fetchResults().toList() )
     {
         if( v.canConvert<KDevelop::VcsEvent>() )
         {
             newevents << v.value<KDevelop::VcsEvent>();
         }
     }
+    if (newevents.isEmpty()) {
+        return;
+    }
     d->m_rev = newevents.last().revision();
-    if (rowCount()) {
+    if (d->skipFirst) {
         newevents.removeFirst();
+        d->skipFirst = false;
     }
-    d->done = newevents.isEmpty();
+    d->jobEvents += newevents.size();
     addEvents( newevents );
-    d->fetching = false;
+}
+
+void VcsEventLogModel::jobFinished(KJob* job)
+{
+    const bool failed = job->error() != 0;
+    // some jobs only report their results after they finished, so wait for those
+    QTimer::singleShot(0, this, [this, failed] {
+        d->done = failed || d->jobEvents == 0;
+        d->fetching = false;
+    });
 }
 
 }
@@ -34,6 +34,7 @@ namespace KDevelop
 class VcsRevision;
 class IBasicVersionControl;
 class VcsEvent;
+class VcsJob;
 
 /**
  * This is a generic model to store a list of VcsEvents.
@@ -70,7 +71,8 @@ private:
 /**
  * This model stores a list of VcsEvents corresponding to the log obtained
  * via IBasicVersionControl::log for a given revision. The model is populated
- * lazily via @c fetchMore.
+ * lazily via @c fetchMore, one page at a time, and shows the events of a page
+ * as soon as the log job reports them.
  */
 class KDEVPLATFORMVCS_EXPORT VcsEventLogModel : public VcsBasicEventModel
 {
@@ -85,7 +87,8 @@ public:
     bool canFetchMore(const QModelIndex& parent) const override;
 
 private Q_SLOTS:
-    void jobReceivedResults( KJob* job );
+    void jobReceivedResults( KDevelop::VcsJob* job );
+    void jobFinished( KJob* job );
 
 private:
     const QScopedPointer<class VcsEventLogModelPrivate> d;
@@ -206,10 +206,13 @@ VcsEventWidget::VcsEventWidget( const QUrl& url, const VcsRevision& rev, KDevelo
     header->setSectionResizeMode( 1, QHeaderView::Stretch );
     header->setSectionResizeMode( 2, QHeaderView::ResizeToContents );
     header->setSectionResizeMode( 3, QHeaderView::ResizeToContents );
-    // Select first row as soon as the model got populated
+    // Select first row as soon as the model got populated,
+    // but keep the selection when later pages come in
     connect(d->m_logModel, &QAbstractItemModel::rowsInserted, this, [this]() {
         auto view = d->m_ui->eventView;
-        view->setCurrentIndex(view->model()->index(0, 0));
+        if (!view->currentIndex().isValid()) {
+            view->setCurrentIndex(view->model()->index(0, 0));
+        }
     });
 
     d->m_detailModel = new VcsItemEventModel(this);
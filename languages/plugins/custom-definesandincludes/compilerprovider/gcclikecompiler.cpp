@@ -23,15 +23,23 @@
 
 #include "gcclikecompiler.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
 #include <QFileInfo>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QMap>
+#include <QStandardPaths>
+#include <KConfigGroup>
+#include <KSharedConfig>
 #include <interfaces/iruntime.h>
 #include <interfaces/iruntimecontroller.h>
 
 #include <debug.h>
 
+#include <algorithm>
+
 using namespace KDevelop;
 
 namespace
@@ -75,66 +83,175 @@ QStringList languageOptions(const QString& arguments)
     return {QStringLiteral("-std=c++11"), minusXCPlusPlus()};
 }
 
+/// @return the values of the environment variables of @p rt that change the built-in include paths
+QString includeEnvironment(const IRuntime* rt)
+{
+    static const char* const variables[] = {
+        "CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH", "OBJC_INCLUDE_PATH",
+        "GCC_EXEC_PREFIX", "COMPILER_PATH", "SDKROOT",
+    };
+    QString environment;
+    for (const char* variable : variables) {
+        environment += QLatin1String(variable) + QLatin1Char('=')
+                     + QString::fromLocal8Bit(rt->getenv(variable)) + QLatin1Char('\n');
+    }
+    return environment;
+}
+
+/// @return whether all of @p includePaths are existing directories
+bool includePathsExist(const Path::List& includePaths)
+{
+    return std::all_of(includePaths.begin(), includePaths.end(), [](const Path& includePath) {
+        return includePath.isValid() && QFileInfo(includePath.toLocalFile()).isDir();
+    });
+}
+
+QString probeCacheName() { return QStringLiteral("kdevcompilerprobecache"); }
+
+/// @return the file of the compiler @p program as seen from the host, or an empty string if it can't be found
+QString hostExecutable(const IRuntime* rt, const QString& program)
+{
+    if (QDir::isAbsolutePath(program)) {
+        const QString candidate = rt->pathInHost(Path(program)).toLocalFile();
+        return QFileInfo(candidate).isFile() ? candidate : QString();
+    }
+
+#ifdef Q_OS_WIN
+    const QChar separator = QLatin1Char(';');
+#else
+    const QChar separator = QLatin1Char(':');
+#endif
+    const auto searchPaths = QString::fromLocal8Bit(rt->getenv("PATH")).split(separator, QString::SkipEmptyParts);
+    for (const QString& searchPath : searchPaths) {
+        const QString candidate = rt->pathInHost(Path(Path(searchPath), program)).toLocalFile();
+        const QFileInfo info(candidate);
+        if (info.isFile() && info.isExecutable()) {
+            return candidate;
+        }
+    }
+    return {};
+}
+
 }
 
 Defines GccLikeCompiler::defines(const QString& arguments) const
+{
+    return definesIncludes(arguments).definedMacros;
+}
+
+Path::List GccLikeCompiler::includes(const QString& arguments) const
+{
+    return definesIncludes(arguments).includePaths;
+}
+
+const GccLikeCompiler::DefinesIncludes& GccLikeCompiler::definesIncludes(const QString& arguments) const
 {
     auto& data = m_definesIncludes[arguments];
-    if (!data.definedMacros.isEmpty() ) {
-        return data.definedMacros;
+    if (data.probed) {
+        return data;
     }
-
-    // #define a 1
-    // #define a
-    QRegExp defineExpression( "#define\\s+(\\S+)(?:\\s+(.*)\\s*)?");
+    // don't run a failing compiler over and over again, the cache is dropped when the runtime changes
+    data.probed = true;
 
     const auto rt = ICore::self()->runtimeController()->currentRuntime();
-    QProcess proc;
-    proc.setProcessChannelMode( QProcess::MergedChannels );
-
-    // TODO: what about -mXXX or -target= flags, some of these change search paths/defines
-    auto compilerArguments = languageOptions(arguments);
-    compilerArguments.append(QStringLiteral("-dM"));
-    compilerArguments.append(QStringLiteral("-E"));
-    compilerArguments.append(QProcess::nullDevice());
-
-    proc.setProgram(path());
-    proc.setArguments(compilerArguments);
-    rt->startProcess(&proc);
-
-    if ( !proc.waitForStarted( 2000 ) || !proc.waitForFinished( 2000 ) ) {
-        qCDebug(DEFINESANDINCLUDES) <<  "Unable to read standard macro definitions from "<< path();
-        return {};
-    }
+    const auto options = languageOptions(arguments);
 
-    if (proc.exitCode() != 0) {
-        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching defines for the compiler:" << path() << proc.readAll();
-        return {};
+    // the compiler binary we probe, a changed binary may have different built-ins
+    QString identity;
+    const QString executable = hostExecutable(rt, path());
+    if (!executable.isEmpty()) {
+        const QFileInfo info(executable);
+        identity = QStringLiteral("%1:%2:%3").arg(info.canonicalFilePath())
+                                            .arg(info.size())
+                                            .arg(info.lastModified().toMSecsSinceEpoch());
     }
 
-    while ( proc.canReadLine() ) {
-        auto line = proc.readLine();
+    const QString key = rt->name() + QLatin1Char('\n') + path() + QLatin1Char('\n') + options.join(QLatin1Char(' '))
+                      + QLatin1Char('\n') + includeEnvironment(rt);
+    const QString groupName = QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+    auto cache = KSharedConfig::openConfig(probeCacheName(), KConfig::SimpleConfig, QStandardPaths::CacheLocation);
+    KConfigGroup group = cache->group(groupName);
+
+    QByteArray definesOutput;
+    QByteArray includesOutput;
+    if (!identity.isEmpty() && group.readEntry("Identity", QString()) == identity) {
+        definesOutput = group.readEntry("DefinesOutput", QByteArray());
+        includesOutput = group.readEntry("IncludesOutput", QByteArray());
 
-        if ( defineExpression.indexIn( line ) != -1 ) {
-            data.definedMacros[defineExpression.cap( 1 )] = defineExpression.cap( 2 ).trimmed();
+        // an include directory went away, e.g. with an uninstalled package, so the output is outdated
+        data.includePaths = parseIncludes(rt, includesOutput);
+        if (includePathsExist(data.includePaths)) {
+            data.definedMacros = parseDefines(definesOutput);
+            return data;
         }
+        group.deleteGroup();
+    }
+
+    // both probes are independent, so let them run at the same time
+    QProcess definesProc;
+    QProcess includesProc;
+    startProbe(&definesProc, options + QStringList{QStringLiteral("-dM"), QStringLiteral("-E"), QProcess::nullDevice()});
+    startProbe(&includesProc, options + QStringList{QStringLiteral("-E"), QStringLiteral("-v"), QProcess::nullDevice()});
+
+    if (!finishProbe(&definesProc, &definesOutput)) {
+        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching defines for the compiler:" << path() << definesOutput;
+        definesOutput.clear();
+    }
+    if (!finishProbe(&includesProc, &includesOutput)) {
+        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching includes for the compiler:" << path() << includesOutput;
+        includesOutput.clear();
+    }
+
+    if (!identity.isEmpty() && !definesOutput.isEmpty() && !includesOutput.isEmpty()) {
+        group.writeEntry("Compiler", path());
+        group.writeEntry("Identity", identity);
+        group.writeEntry("DefinesOutput", definesOutput);
+        group.writeEntry("IncludesOutput", includesOutput);
+        cache->sync();
     }
 
-    return data.definedMacros;
+    data.definedMacros = parseDefines(definesOutput);
+    data.includePaths = parseIncludes(rt, includesOutput);
+    return data;
 }
 
-Path::List GccLikeCompiler::includes(const QString& arguments) const
+void GccLikeCompiler::startProbe(QProcess* proc, const QStringList& arguments) const
 {
-    auto& data = m_definesIncludes[arguments];
-    if ( !data.includePaths.isEmpty() ) {
-        return data.includePaths;
+    proc->setProcessChannelMode( QProcess::MergedChannels );
+    proc->setProgram(path());
+    proc->setArguments(arguments);
+    ICore::self()->runtimeController()->currentRuntime()->startProcess(proc);
+}
+
+bool GccLikeCompiler::finishProbe(QProcess* proc, QByteArray* output) const
+{
+    if ( !proc->waitForStarted( 2000 ) || !proc->waitForFinished( 2000 ) ) {
+        qCDebug(DEFINESANDINCLUDES) <<  "Unable to run" << path() << proc->arguments();
+        return false;
     }
 
-    const auto rt = ICore::self()->runtimeController()->currentRuntime();
-    QProcess proc;
-    proc.setProcessChannelMode( QProcess::MergedChannels );
+    *output = proc->readAll();
+    return proc->exitCode() == 0;
+}
 
-    // The following command will spit out a bunch of information we don't care
+Defines GccLikeCompiler::parseDefines(const QByteArray& output)
+{
+    // #define a 1
+    // #define a
+    QRegExp defineExpression( "#define\\s+(\\S+)(?:\\s+(.*)\\s*)?");
+
+    Defines defines;
+    foreach (const QByteArray& line, output.split('\n')) {
+        if ( defineExpression.indexIn( QString::fromUtf8(line) ) != -1 ) {
+            defines[defineExpression.cap( 1 )] = defineExpression.cap( 2 ).trimmed();
+        }
+    }
+    return defines;
+}
+
+Path::List GccLikeCompiler::parseIncludes(const IRuntime* rt, const QByteArray& output)
+{
+    // The compiler spits out a bunch of information we don't care
     // about before spitting out the include paths.  The parts we care about
     // look like this:
     // #include "..." search starts here:
@@ -147,25 +264,6 @@ Path::List GccLikeCompiler::includes(const QString& arguments) const
     //  /usr/include
     // End of search list.
 
-    auto compilerArguments = languageOptions(arguments);
-    compilerArguments.append(QStringLiteral("-E"));
-    compilerArguments.append(QStringLiteral("-v"));
-    compilerArguments.append(QProcess::nullDevice());
-
-    proc.setProgram(path());
-    proc.setArguments(compilerArguments);
-    rt->startProcess(&proc);
-
-    if ( !proc.waitForStarted( 2000 ) || !proc.waitForFinished( 2000 ) ) {
-        qCDebug(DEFINESANDINCLUDES) <<  "Unable to read standard include paths from " << path();
-        return {};
-    }
-
-    if (proc.exitCode() != 0) {
-        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching includes for the compiler:" << path() << proc.readAll();
-        return {};
-    }
-
     // We'll use the following constants to know what we're currently parsing.
     enum Status {
         Initial,
@@ -175,8 +273,8 @@ Path::List GccLikeCompiler::includes(const QString& arguments) const
     };
     Status mode = Initial;
 
-    const auto output = QString::fromLocal8Bit( proc.readAllStandardOutput() );
-    foreach( const QString &line, output.split( '\n' ) ) {
+    Path::List includePaths;
+    foreach( const QString &line, QString::fromLocal8Bit( output ).split( '\n' ) ) {
         switch ( mode ) {
             case Initial:
                 if ( line.indexOf( QLatin1String("#include \"...\"") ) != -1 ) {
@@ -196,7 +294,7 @@ Path::List GccLikeCompiler::includes(const QString& arguments) const
                 } else {
                     // This is an include path, add it to the list.
                     auto hostPath = rt->pathInHost(Path(line.trimmed()));
-                    data.includePaths << Path(QFileInfo(hostPath.toLocalFile()).canonicalFilePath());
+                    includePaths << Path(QFileInfo(hostPath.toLocalFile()).canonicalFilePath());
                 }
                 break;
             default:
@@ -207,12 +305,23 @@ Path::List GccLikeCompiler::includes(const QString& arguments) const
         }
     }
 
-    return data.includePaths;
+    return includePaths;
 }
 
 void GccLikeCompiler::invalidateCache()
 {
     m_definesIncludes.clear();
+
+    // the probes are run again, so don't let them be answered from the disk either
+    auto cache = KSharedConfig::openConfig(probeCacheName(), KConfig::SimpleConfig, QStandardPaths::CacheLocation);
+    const auto groups = cache->groupList();
+    for (const QString& groupName : groups) {
+        KConfigGroup group = cache->group(groupName);
+        if (group.readEntry("Compiler", QString()) == path()) {
+            group.deleteGroup();
+        }
+    }
+    cache->sync();
 }
 
 GccLikeCompiler::GccLikeCompiler(const QString& name, const QString& path, bool editable, const QString& factoryName):
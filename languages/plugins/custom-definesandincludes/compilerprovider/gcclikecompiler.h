@@ -26,6 +26,12 @@
 
 #include "icompiler.h"
 
+class QProcess;
+
+namespace KDevelop {
+class IRuntime;
+}
+
 class GccLikeCompiler : public QObject, public ICompiler
 {
     Q_OBJECT
@@ -42,8 +48,22 @@ private:
     struct DefinesIncludes {
         KDevelop::Defines definedMacros;
         KDevelop::Path::List includePaths;
+        bool probed = false;
     };
 
+    /**
+     * @return the built-in defines and include paths of the compiler for @p arguments.
+     *
+     * The compiler output is cached on disk, keyed by the runtime, the compiler binary, the
+     * language options and the include related environment variables, so the compiler only
+     * needs to be run when one of them changes or when a cached include path no longer exists.
+     */
+    const DefinesIncludes& definesIncludes(const QString& arguments) const;
+    void startProbe(QProcess* proc, const QStringList& arguments) const;
+    bool finishProbe(QProcess* proc, QByteArray* output) const;
+    static KDevelop::Defines parseDefines(const QByteArray& output);
+    static KDevelop::Path::List parseIncludes(const KDevelop::IRuntime* rt, const QByteArray& output);
+
     /// List of defines/includes per arguments
     mutable QHash<QString, DefinesIncludes> m_definesIncludes;
 };
@@ -23,6 +23,7 @@
 
 #include "test_compilerprovider.h"
 
+#include <QStandardPaths>
 #include <QTest>
 #include <QTemporaryFile>
 
@@ -84,6 +85,8 @@ void testAddingEntry(SettingsManager* settings, KConfig* config){
 
 void TestCompilerProvider::initTestCase()
 {
+    // keep the compiler probe cache out of the user's cache directory
+    QStandardPaths::setTestModeEnabled(true);
     AutoTestShell::init();
     TestCore::initialize();
 }
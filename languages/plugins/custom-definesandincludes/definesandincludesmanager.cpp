@@ -43,26 +43,27 @@ using namespace KDevelop;
 
 namespace
 {
-///@return: The ConfigEntry, with includes/defines from @p paths for all parent folders of @p item.
-static ConfigEntry findConfigForItem(QVector<ConfigEntry> paths, const KDevelop::ProjectBaseItem* item)
+///@return the path @p entry of the project in @p rootDirectory is configured for
+static Path entryPath(const Path& rootDirectory, const ConfigEntry& entry)
+{
+    Path targetDirectory = rootDirectory;
+    // note: a dot represents the project root
+    if (entry.path != QLatin1String(".")) {
+        targetDirectory.addPath(entry.path);
+    }
+    return targetDirectory;
+}
+
+///@return: The ConfigEntry, with includes/defines from @p paths for @p itemPath and all its parent folders.
+///@p paths must be sorted with sortConfigEntries.
+static ConfigEntry findConfigForPath(const QVector<ConfigEntry>& paths, const Path& rootDirectory, const Path& itemPath)
 {
     ConfigEntry ret;
 
-    const Path itemPath = item->path();
-    const Path rootDirectory = item->project()->path();
     Path closestPath;
 
-    std::sort(paths.begin(), paths.end(), [] (const ConfigEntry& lhs, const ConfigEntry& rhs) {
-        // sort in reverse order to do a bottom-up search
-        return lhs.path > rhs.path;
-    });
-
     for (const ConfigEntry & entry : paths) {
-        Path targetDirectory = rootDirectory;
-        // note: a dot represents the project root
-        if (entry.path != QLatin1String(".")) {
-            targetDirectory.addPath(entry.path);
-        }
+        const Path targetDirectory = entryPath(rootDirectory, entry);
 
         if (targetDirectory == itemPath || targetDirectory.isParentOf(itemPath)) {
             ret.includes += entry.includes;
@@ -87,6 +88,14 @@ static ConfigEntry findConfigForItem(QVector<ConfigEntry> paths, const KDevelop:
     return ret;
 }
 
+void sortConfigEntries(QVector<ConfigEntry>* paths)
+{
+    std::sort(paths->begin(), paths->end(), [] (const ConfigEntry& lhs, const ConfigEntry& rhs) {
+        // sort in reverse order to do a bottom-up search
+        return lhs.path > rhs.path;
+    });
+}
+
 void merge(Defines* target, const Defines& source)
 {
     if (target->isEmpty()) {
@@ -130,6 +139,12 @@ DefinesAndIncludesManager::DefinesAndIncludesManager( QObject* parent, const QVa
     , m_noProjectIPM(new NoProjectIncludePathsManager())
 {
     registerProvider(m_settings->provider());
+
+    auto projectController = ICore::self()->projectController();
+    connect(projectController, &IProjectController::projectConfigurationChanged,
+            this, &DefinesAndIncludesManager::invalidateUserConfig);
+    connect(projectController, &IProjectController::projectClosing,
+            this, &DefinesAndIncludesManager::invalidateUserConfig);
 #ifdef Q_OS_OSX
     m_defaultFrameworkDirectories += Path(QStringLiteral("/Library/Frameworks"));
     m_defaultFrameworkDirectories += Path(QStringLiteral("/System/Library/Frameworks"));
@@ -138,6 +153,35 @@ DefinesAndIncludesManager::DefinesAndIncludesManager( QObject* parent, const QVa
 
 DefinesAndIncludesManager::~DefinesAndIncludesManager() = default;
 
+ConfigEntry DefinesAndIncludesManager::userConfigForItem(ProjectBaseItem* item) const
+{
+    auto project = item->project();
+    auto projectIt = m_userConfigs.find(project);
+    if (projectIt == m_userConfigs.end()) {
+        UserConfig config;
+        config.paths = m_settings->readPaths(project->projectConfiguration().data());
+        sortConfigEntries(&config.paths);
+        for (const ConfigEntry& entry : qAsConst(config.paths)) {
+            config.entryPaths.insert(entryPath(project->path(), entry));
+        }
+        projectIt = m_userConfigs.insert(project, config);
+    }
+
+    // a file gets the configuration of its folder, unless an entry is configured for the file itself
+    const Path itemPath = item->path();
+    const Path configPath = (item->file() && !projectIt->entryPaths.contains(itemPath)) ? itemPath.parent() : itemPath;
+    auto it = projectIt->pathConfigs.constFind(configPath);
+    if (it == projectIt->pathConfigs.constEnd()) {
+        it = projectIt->pathConfigs.insert(configPath, findConfigForPath(projectIt->paths, project->path(), configPath));
+    }
+    return *it;
+}
+
+void DefinesAndIncludesManager::invalidateUserConfig(IProject* project)
+{
+    m_userConfigs.remove(project);
+}
+
 Defines DefinesAndIncludesManager::defines( ProjectBaseItem* item, Type type  ) const
 {
     Q_ASSERT(QThread::currentThread() == qApp->thread());
@@ -163,9 +207,7 @@ Defines DefinesAndIncludesManager::defines( ProjectBaseItem* item, Type type  )
 
     // Manually set defines have the highest priority and overwrite values of all other types of defines.
     if (type & UserDefined) {
-        auto cfg = item->project()->projectConfiguration().data();
-
-        merge(&defines, findConfigForItem(m_settings->readPaths(cfg), item).defines);
+        merge(&defines, userConfigForItem(item).defines);
     }
 
     merge(&defines, m_noProjectIPM->includesAndDefines(item->path().path()).second);
@@ -184,9 +226,7 @@ Path::List DefinesAndIncludesManager::includes( ProjectBaseItem* item, Type type
     Path::List includes;
 
     if (type & UserDefined) {
-        auto cfg = item->project()->projectConfiguration().data();
-
-        includes += KDevelop::toPathList(findConfigForItem(m_settings->readPaths(cfg), item).includes);
+        includes += KDevelop::toPathList(userConfigForItem(item).includes);
     }
 
     if ( type & ProjectSpecific ) {
@@ -356,8 +396,7 @@ QString DefinesAndIncludesManager::parserArguments(KDevelop::ProjectBaseItem* it
 
     Q_ASSERT(QThread::currentThread() == qApp->thread());
 
-    auto cfg = item->project()->projectConfiguration().data();
-    const auto arguments = findConfigForItem(m_settings->readPaths(cfg), item).parserArguments;
+    const auto arguments = userConfigForItem(item).parserArguments;
     return argumentsForPath(item->path(), arguments);
 }
 
@@ -22,6 +22,8 @@
 #ifndef CUSTOMDEFINESANDINCLUDESMANAGER_H
 #define CUSTOMDEFINESANDINCLUDESMANAGER_H
 
+#include <QHash>
+#include <QSet>
 #include <QVariantList>
 #include <QVector>
 #include <QScopedPointer>
@@ -78,11 +80,27 @@ public:
     int configPages() const override;
 
 private:
+    /// @return the user defined configuration for @p item, from the cache of its project
+    ConfigEntry userConfigForItem(KDevelop::ProjectBaseItem* item) const;
+    void invalidateUserConfig(KDevelop::IProject* project);
+
+    struct UserConfig
+    {
+        /// The configured entries of the project, sorted for a bottom-up search
+        QVector<ConfigEntry> paths;
+        /// The paths the entries are configured for
+        QSet<KDevelop::Path> entryPaths;
+        /// The configuration for each folder, and for each file with an entry of its own
+        QHash<KDevelop::Path, ConfigEntry> pathConfigs;
+    };
+
     QVector<Provider*> m_providers;
     QVector<BackgroundProvider*> m_backgroundProviders;
     SettingsManager* m_settings;
     QScopedPointer<NoProjectIncludePathsManager> m_noProjectIPM;
     KDevelop::Path::List m_defaultFrameworkDirectories;
+    /// Reading the settings is expensive and they are asked for several times for each parsed file
+    mutable QHash<KDevelop::IProject*, UserConfig> m_userConfigs;
 };
 
 #endif // CUSTOMDEFINESANDINCLUDESMANAGER_H
@@ -38,49 +38,148 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QtConcurrentRun>
+#include <QtConcurrentMap>
 #include <QFutureWatcher>
 #include <QRegularExpression>
+#include <QThread>
 
 using namespace KDevelop;
 
 namespace {
 
-CMakeFilesCompilationData importCommands(const Path& commandsFile)
+/**
+ * Shares equal compile flags between files.
+ *
+ * Most files of a target are compiled with the same include paths and defines,
+ * so only one copy of each distinct set is kept and the files share it.
+ */
+class FlagSetPool
 {
-    // NOTE: to get compile_commands.json, you need -DCMAKE_EXPORT_COMPILE_COMMANDS=ON
-    QFile f(commandsFile.toLocalFile());
-    bool r = f.open(QFile::ReadOnly|QFile::Text);
-    if(!r) {
-        qCWarning(CMAKE) << "Couldn't open commands file" << commandsFile;
-        return {};
+public:
+    /// @return the index of the flag set equal to @p flags, after adding it if it is new
+    int intern(const CMakeFile& flags)
+    {
+        const uint hash = hashFlags(flags);
+        for (auto it = m_index.constFind(hash); it != m_index.constEnd() && it.key() == hash; ++it) {
+            const CMakeFile& other = m_flagSets.at(*it);
+            if (other.includes == flags.includes && other.frameworkDirectories == flags.frameworkDirectories && other.defines == flags.defines) {
+                return *it;
+            }
+        }
+        m_index.insert(hash, m_flagSets.size());
+        m_flagSets.append(flags);
+        return m_flagSets.size() - 1;
     }
 
-    qCDebug(CMAKE) << "Found commands file" << commandsFile;
+    const QVector<CMakeFile>& flagSets() const
+    {
+        return m_flagSets;
+    }
 
-    CMakeFilesCompilationData data;
-    QJsonParseError error;
-    const QJsonDocument document = QJsonDocument::fromJson(f.readAll(), &error);
-    if (error.error) {
-        qCWarning(CMAKE) << "Failed to parse JSON in commands file:" << error.errorString() << commandsFile;
-        data.isValid = false;
-        return data;
-    } else if (!document.isArray()) {
-        qCWarning(CMAKE) << "JSON document in commands file is not an array: " << commandsFile;
-        data.isValid = false;
-        return data;
+private:
+    static uint hashFlags(const CMakeFile& flags)
+    {
+        uint hash = qHashRange(flags.includes.constBegin(), flags.includes.constEnd());
+        hash = hash * 31 + qHashRange(flags.frameworkDirectories.constBegin(), flags.frameworkDirectories.constEnd());
+        // the order of a hash is arbitrary, so combine the defines commutatively
+        for (auto it = flags.defines.constBegin(), end = flags.defines.constEnd(); it != end; ++it) {
+            hash += qHash(it.key()) ^ qHash(it.value());
+        }
+        return hash;
     }
 
-    MakeFileResolver resolver;
+    QVector<CMakeFile> m_flagSets;
+    QMultiHash<uint, int> m_index;
+};
+
+/// The compile flags of a slice of the compile commands, files refer to them by index
+struct ImportedChunk
+{
+    QVector<CMakeFile> flagSets;
+    QVector<QPair<Path, int>> files;
+    bool isValid = true;
+};
+
+/**
+ * Split the top level array of a compile_commands.json file into the data of its entries.
+ *
+ * Only the nesting of the entries is looked at, so this is much cheaper than parsing
+ * the whole file into one QJsonDocument. The entries share the data of @p json,
+ * so they must not outlive it.
+ *
+ * @return false if @p json does not contain a complete array
+ */
+bool splitEntries(const QByteArray& json, QVector<QByteArray>* entries)
+{
+    const char* data = json.constData();
+    const int size = json.size();
+
+    int pos = 0;
+    while (pos < size && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\n' || data[pos] == '\r')) {
+        ++pos;
+    }
+    if (pos == size || data[pos] != '[') {
+        return false;
+    }
+
+    int depth = 0;
+    int entryStart = -1;
+    bool inString = false;
+    for (++pos; pos < size; ++pos) {
+        const char c = data[pos];
+        if (inString) {
+            if (c == '\\') {
+                ++pos;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            if (depth++ == 0) {
+                entryStart = pos;
+            }
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                // end of the top level array
+                return c == ']';
+            }
+            if (--depth == 0) {
+                entries->append(QByteArray::fromRawData(data + entryStart, pos + 1 - entryStart));
+            }
+        }
+    }
+    return false;
+}
+
+ImportedChunk importEntries(const QVector<QByteArray>& entries)
+{
     static const QString KEY_COMMAND = QStringLiteral("command");
     static const QString KEY_DIRECTORY = QStringLiteral("directory");
     static const QString KEY_FILE = QStringLiteral("file");
+
+    ImportedChunk chunk;
+    chunk.files.reserve(entries.size());
+    MakeFileResolver resolver;
+    FlagSetPool pool;
     auto rt = ICore::self()->runtimeController()->currentRuntime();
-    foreach(const QJsonValue& value, document.array()) {
-        if (!value.isObject()) {
-            qCWarning(CMAKE) << "JSON command file entry is not an object:" << value;
+    auto convert = [rt](const Path &path) { return rt->pathInHost(path); };
+    // flag sets are converted once, not once per file
+    QHash<int, int> convertedIds;
+    FlagSetPool convertedPool;
+
+    for (const QByteArray& entryData : entries) {
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(entryData, &error);
+        if (error.error) {
+            qCWarning(CMAKE) << "Failed to parse JSON in commands file:" << error.errorString();
+            chunk.isValid = false;
+            return chunk;
+        } else if (!document.isObject()) {
+            qCWarning(CMAKE) << "JSON command file entry is not an object:" << entryData;
             continue;
         }
-        const QJsonObject entry = value.toObject();
+        const QJsonObject entry = document.object();
         if (!entry.contains(KEY_FILE) || !entry.contains(KEY_COMMAND) || !entry.contains(KEY_DIRECTORY)) {
             qCWarning(CMAKE) << "JSON command file entry does not contain required keys:" << entry;
             continue;
@@ -88,15 +187,80 @@ CMakeFilesCompilationData importCommands(const Path& commandsFile)
 
         PathResolutionResult result = resolver.processOutput(entry[KEY_COMMAND].toString(), entry[KEY_DIRECTORY].toString());
 
-        auto convert = [rt](const Path &path) { return rt->pathInHost(path); };
+        CMakeFile flags;
+        flags.includes = result.paths;
+        flags.frameworkDirectories = result.frameworkDirectories;
+        flags.defines = result.defines;
+        const int id = pool.intern(flags);
+
+        auto it = convertedIds.constFind(id);
+        if (it == convertedIds.constEnd()) {
+            CMakeFile ret;
+            ret.includes = kTransform<Path::List>(flags.includes, convert);
+            ret.frameworkDirectories = kTransform<Path::List>(flags.frameworkDirectories, convert);
+            ret.defines = flags.defines;
+            it = convertedIds.insert(id, convertedPool.intern(ret));
+        }
 
-        CMakeFile ret;
-        ret.includes = kTransform<Path::List>(result.paths, convert);
-        ret.frameworkDirectories = kTransform<Path::List>(result.frameworkDirectories, convert);
-        ret.defines = result.defines;
         const Path path(rt->pathInHost(Path(entry[KEY_FILE].toString())));
         qCDebug(CMAKE) << "entering..." << path << entry[KEY_FILE];
-        data.files[path] = ret;
+        chunk.files.append(qMakePair(path, *it));
+    }
+
+    chunk.flagSets = convertedPool.flagSets();
+    return chunk;
+}
+
+CMakeFilesCompilationData importCommands(const Path& commandsFile)
+{
+    // NOTE: to get compile_commands.json, you need -DCMAKE_EXPORT_COMPILE_COMMANDS=ON
+    QFile f(commandsFile.toLocalFile());
+    bool r = f.open(QFile::ReadOnly);
+    if(!r) {
+        qCWarning(CMAKE) << "Couldn't open commands file" << commandsFile;
+        return {};
+    }
+
+    qCDebug(CMAKE) << "Found commands file" << commandsFile;
+
+    CMakeFilesCompilationData data;
+    // map the file instead of reading it, the file can be hundreds of megabytes for big projects
+    // and only the pages of the entries being parsed need to be in memory
+    QByteArray json;
+    if (uchar* mapped = f.size() > 0 ? f.map(0, f.size()) : nullptr) {
+        json = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), int(f.size()));
+    } else {
+        json = f.readAll();
+    }
+    QVector<QByteArray> entries;
+    if (!splitEntries(json, &entries)) {
+        qCWarning(CMAKE) << "JSON document in commands file is not an array: " << commandsFile;
+        data.isValid = false;
+        return data;
+    }
+
+    // parse the entries in parallel, in chunks so each thread can share its flag sets
+    const int chunkCount = qMax(1, QThread::idealThreadCount() * 4);
+    const int chunkSize = qMax(64, (entries.size() + chunkCount - 1) / chunkCount);
+    QVector<QVector<QByteArray>> chunks;
+    for (int i = 0; i < entries.size(); i += chunkSize) {
+        chunks.append(entries.mid(i, chunkSize));
+    }
+    const auto importedChunks = QtConcurrent::blockingMapped<QVector<ImportedChunk>>(chunks, importEntries);
+
+    FlagSetPool pool;
+    data.files.reserve(entries.size());
+    for (const ImportedChunk& chunk : importedChunks) {
+        if (!chunk.isValid) {
+            qCWarning(CMAKE) << "Failed to parse JSON in commands file:" << commandsFile;
+            data.isValid = false;
+            return data;
+        }
+
+        const auto ids = kTransform<QVector<int>>(chunk.flagSets, [&pool](const CMakeFile& flags) { return pool.intern(flags); });
+        for (const auto& file : chunk.files) {
+            data.files[file.first] = pool.flagSets().at(ids.at(file.second));
+        }
     }
 
     data.isValid = true;
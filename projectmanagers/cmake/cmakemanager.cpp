@@ -52,6 +52,7 @@
 #include <interfaces/icore.h>
 #include <interfaces/idocumentcontroller.h>
 #include <interfaces/iprojectcontroller.h>
+#include <interfaces/ilanguagecontroller.h>
 #include <interfaces/iproject.h>
 #include <interfaces/iplugincontroller.h>
 #include <interfaces/iruntimecontroller.h>
@@ -70,6 +71,7 @@
 #include <language/duchain/duchainlock.h>
 #include <language/duchain/use.h>
 #include <language/duchain/duchain.h>
+#include <language/duchain/topducontext.h>
 
 Q_DECLARE_METATYPE(KDevelop::IProject*);
 
@@ -307,16 +309,77 @@ bool CMakeManager::reload(KDevelop::ProjectFolderItem* folder)
     project->setReloadJob(job);
     ICore::self()->runController()->registerJob( job );
     if (folder == project->projectItem()) {
-        connect(job, &KJob::finished, this, [project](KJob* job) {
+        // remember how the files were compiled, so only the changed ones need to be parsed again
+        const auto projectIt = m_projects.constFind(project);
+        const auto previousFiles = projectIt == m_projects.constEnd() ? QHash<Path, CMakeFile>() : projectIt->compilationData.files;
+        const auto previousOpenFiles = previousFiles.isEmpty() ? QHash<IndexedString, CMakeFile>() : openFilesInformation(project);
+        connect(job, &KJob::finished, this, [this, project, previousFiles, previousOpenFiles](KJob* job) {
             if (job->error())
                 return;
-            KDevelop::ICore::self()->projectController()->reparseProject(project, true);
+            if (previousFiles.isEmpty() || !m_projects.contains(project)) {
+                KDevelop::ICore::self()->projectController()->reparseProject(project, true);
+                return;
+            }
+            reparseChangedFiles(project, previousFiles, previousOpenFiles);
         });
     }
 
     return true;
 }
 
+static bool sameFlags(const CMakeFile& a, const CMakeFile& b)
+{
+    return a.includes == b.includes
+        && a.frameworkDirectories == b.frameworkDirectories
+        && a.defines == b.defines;
+}
+
+QHash<IndexedString, CMakeFile> CMakeManager::openFilesInformation(IProject* project) const
+{
+    QHash<IndexedString, CMakeFile> ret;
+    foreach (auto document, ICore::self()->documentController()->openDocuments()) {
+        const IndexedString url(document->url());
+        const auto items = project->filesForPath(url);
+        if (!items.isEmpty()) {
+            ret.insert(url, fileInformation(items.first()));
+        }
+    }
+    return ret;
+}
+
+void CMakeManager::reparseChangedFiles(IProject* project, const QHash<Path, CMakeFile>& previousFiles,
+                                       const QHash<IndexedString, CMakeFile>& previousOpenFiles)
+{
+    const auto& files = m_projects[project].compilationData.files;
+
+    QSet<IndexedString> changedFiles;
+    for (auto it = files.constBegin(), end = files.constEnd(); it != end; ++it) {
+        const auto previous = previousFiles.constFind(it.key());
+        if (previous == previousFiles.constEnd() || !sameFlags(*previous, *it)) {
+            changedFiles.insert(IndexedString(it.key().toUrl()));
+        }
+    }
+    // files that are no longer compiled now take their flags from a sibling or parent
+    for (auto it = previousFiles.constBegin(), end = previousFiles.constEnd(); it != end; ++it) {
+        if (!files.contains(it.key())) {
+            changedFiles.insert(IndexedString(it.key().toUrl()));
+        }
+    }
+    // headers and other open documents that are not compiled themselves
+    const auto openFiles = openFilesInformation(project);
+    for (auto it = openFiles.constBegin(), end = openFiles.constEnd(); it != end; ++it) {
+        const auto previous = previousOpenFiles.constFind(it.key());
+        if (previous == previousOpenFiles.constEnd() || !sameFlags(*previous, *it)) {
+            changedFiles.insert(it.key());
+        }
+    }
+
+    qCDebug(CMAKE) << "reparsing" << changedFiles.size() << "of" << files.size() << "files with changed compile flags in" << project->name();
+    if (!changedFiles.isEmpty()) {
+        ICore::self()->projectController()->reparseFiles(project, changedFiles, true);
+    }
+}
+
 static void populateTargets(ProjectFolderItem* folder, const QHash<KDevelop::Path, QVector<CMakeTarget>>& targets)
 {
     static QSet<QString> standardTargets = {
@@ -871,6 +934,7 @@ QPair<QString, QString> CMakeManager::cacheValue(KDevelop::IProject* /*project*/
 void CMakeManager::projectClosing(IProject* p)
 {
     m_projects.remove(p);
+    CMake::clearTestSuiteCache(p);
 //     delete m_projectsData.take(p);
 //     delete m_watchers.take(p);
 //
@@ -152,6 +152,12 @@ private Q_SLOTS:
 
 private:
     void reloadProjects();
+    /// How the open documents of @p project are compiled right now, including the ones that take their flags from a sibling or parent
+    QHash<KDevelop::IndexedString, CMakeFile> openFilesInformation(KDevelop::IProject* project) const;
+    /// Parses the files of @p project again that are compiled differently than they were with @p previousFiles
+    /// and the open documents that are compiled differently than with @p previousOpenFiles
+    void reparseChangedFiles(KDevelop::IProject* project, const QHash<KDevelop::Path, CMakeFile>& previousFiles,
+                             const QHash<KDevelop::IndexedString, CMakeFile>& previousOpenFiles);
     CMakeFile fileInformation(KDevelop::ProjectBaseItem* item) const;
 
     void folderAdded(KDevelop::ProjectFolderItem* folder);
@@ -22,11 +22,16 @@
 #include "cmakeprojectdata.h"
 
 #include <QFileInfo>
+#include <QDateTime>
 #include <QDir>
+#include <QMutex>
 #include <QProcess>
+#include <QtConcurrentMap>
 #include <QTemporaryDir>
 #include <QRegularExpression>
 
+#include <algorithm>
+
 #include <KShell>
 #include <KLocalizedString>
 #include <kconfiggroup.h>
@@ -119,6 +124,78 @@ QString readBuildDirParameter( KDevelop::IProject* project, const QString& key,
         return aDefault;
 }
 
+struct CTestFile
+{
+    QDateTime lastModified;
+    qint64 size;
+    CMakeFileContent contents;
+};
+
+// every build directory has its own CTestTestfile.cmake, which only changes when its tests change
+QMutex ctestFileCacheMutex;
+QHash<QString, CTestFile> ctestFileCache;
+
+/// @return the contents of the CTestTestfile.cmake in @p buildDir, it only gets parsed again when it changed
+CMakeFileContent readCTestFile(const Path& buildDir)
+{
+    const QString fileName = buildDir.toLocalFile() + QLatin1String("/CTestTestfile.cmake");
+    const QFileInfo info(fileName);
+    const QDateTime lastModified = info.lastModified();
+    const qint64 size = info.size();
+
+    {
+        QMutexLocker lock(&ctestFileCacheMutex);
+        auto it = ctestFileCache.constFind(fileName);
+        if (it != ctestFileCache.constEnd() && it->lastModified == lastModified && it->size == size) {
+            return it->contents;
+        }
+    }
+
+    const CMakeFileContent contents = CMakeListsParser::readCMakeFile(fileName);
+    QMutexLocker lock(&ctestFileCacheMutex);
+    ctestFileCache.insert(fileName, {lastModified, size, contents});
+    return contents;
+}
+
+QVector<Test> collectTestSuites(const Path& buildDir, const QHash<Path, CMakeFileContent>& files)
+{
+    QVector<Test> tests;
+    for (const auto& entry: files.value(buildDir)) {
+        if (entry.name == QLatin1String("add_test")) {
+            auto args = entry.arguments;
+
+            Test test;
+            test.name = args.takeFirst().value;
+            test.executable = args.takeFirst().value;
+            test.arguments = kTransform<QStringList>(args, [](const CMakeFunctionArgument& arg) { return arg.value; });
+            tests += test;
+        } else if (entry.name == QLatin1String("subdirs")) {
+            tests += collectTestSuites(Path(buildDir, entry.arguments.constFirst().value), files);
+        } else if (entry.name == QLatin1String("set_tests_properties")) {
+            if(entry.arguments.count() < 4 || entry.arguments.count() % 2) {
+                qCWarning(CMAKE) << "found set_tests_properties() with unexpected number of arguments:"
+                                 << entry.arguments.count();
+                continue;
+            }
+            if (tests.isEmpty() || entry.arguments.constFirst().value != tests.constLast().name) {
+                qCWarning(CMAKE) << "found set_tests_properties(" << entry.arguments.constFirst().value
+                                 << " ...), but expected test " << tests.constLast().name;
+                continue;
+            }
+            if (entry.arguments[1].value != QLatin1String("PROPERTIES")) {
+                qCWarning(CMAKE) << "found set_tests_properties(" << entry.arguments.constFirst().value
+                                 << entry.arguments.at(1).value << "...), but expected PROPERTIES as second argument";
+                continue;
+            }
+            Test &test = tests.last();
+            for (int i = 2; i < entry.arguments.count(); i += 2)
+                test.properties[entry.arguments[i].value] = entry.arguments[i + 1].value;
+        }
+    }
+
+    return tests;
+}
+
 void writeBuildDirParameter( KDevelop::IProject* project, const QString& key, const QString& value )
 {
     int buildDirIndex = CMake::currentBuildDirIndex(project);
@@ -640,43 +717,49 @@ QString defaultGenerator()
 
 QVector<Test> importTestSuites(const Path &buildDir)
 {
-    const auto contents = CMakeListsParser::readCMakeFile(buildDir.toLocalFile() + "/CTestTestfile.cmake");
-
-    QVector<Test> tests;
-    for (const auto& entry: contents) {
-        if (entry.name == QLatin1String("add_test")) {
-            auto args = entry.arguments;
-
-            Test test;
-            test.name = args.takeFirst().value;
-            test.executable = args.takeFirst().value;
-            test.arguments = kTransform<QStringList>(args, [](const CMakeFunctionArgument& arg) { return arg.value; });
-            tests += test;
-        } else if (entry.name == QLatin1String("subdirs")) {
-            tests += importTestSuites(Path(buildDir, entry.arguments.constFirst().value));
-        } else if (entry.name == QLatin1String("set_tests_properties")) {
-            if(entry.arguments.count() < 4 || entry.arguments.count() % 2) {
-                qCWarning(CMAKE) << "found set_tests_properties() with unexpected number of arguments:"
-                                 << entry.arguments.count();
-                continue;
+    // read the files of one directory level in parallel, then collect the tests in their order
+    QHash<Path, CMakeFileContent> files;
+    QVector<Path> level = {buildDir};
+    while (!level.isEmpty()) {
+        const auto contents = QtConcurrent::blockingMapped<QVector<CMakeFileContent>>(level, readCTestFile);
+
+        QVector<Path> subdirs;
+        for (int i = 0; i < level.size(); ++i) {
+            files.insert(level.at(i), contents.at(i));
+            for (const auto& entry: contents.at(i)) {
+                if (entry.name == QLatin1String("subdirs") && !entry.arguments.isEmpty()) {
+                    const Path subdir(level.at(i), entry.arguments.constFirst().value);
+                    if (!files.contains(subdir)) {
+                        subdirs << subdir;
+                    }
+                }
             }
-            if (tests.isEmpty() || entry.arguments.constFirst().value != tests.constLast().name) {
-                qCWarning(CMAKE) << "found set_tests_properties(" << entry.arguments.constFirst().value
-                                 << " ...), but expected test " << tests.constLast().name;
-                continue;
-            }
-            if (entry.arguments[1].value != QLatin1String("PROPERTIES")) {
-                qCWarning(CMAKE) << "found set_tests_properties(" << entry.arguments.constFirst().value
-                                 << entry.arguments.at(1).value << "...), but expected PROPERTIES as second argument";
-                continue;
-            }
-            Test &test = tests.last();
-            for (int i = 2; i < entry.arguments.count(); i += 2)
-                test.properties[entry.arguments[i].value] = entry.arguments[i + 1].value;
         }
+        level = subdirs;
     }
 
-    return tests;
+    return collectTestSuites(buildDir, files);
+}
+
+void clearTestSuiteCache(IProject* project)
+{
+    QStringList buildDirs;
+    for (int i = 0; i < buildDirCount(project); ++i) {
+        buildDirs << currentBuildDir(project, i).toLocalFile() + QLatin1Char('/');
+    }
+
+    QMutexLocker lock(&ctestFileCacheMutex);
+    for (auto it = ctestFileCache.begin(); it != ctestFileCache.end();) {
+        const QString& fileName = it.key();
+        const bool inProject = std::any_of(buildDirs.constBegin(), buildDirs.constEnd(), [&fileName](const QString& buildDir) {
+            return fileName.startsWith(buildDir);
+        });
+        if (inProject) {
+            it = ctestFileCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 }
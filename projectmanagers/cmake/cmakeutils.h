@@ -252,6 +252,12 @@ namespace CMake
     KDEVCMAKECOMMON_EXPORT QString defaultGenerator();
 
     KDEVCMAKECOMMON_EXPORT QVector<Test> importTestSuites(const KDevelop::Path &buildDir);
+
+    /**
+     * Drops the CTestTestfile.cmake files read by importTestSuites() from the build directories of @p project,
+     * e.g. when it gets closed.
+     */
+    KDEVCMAKECOMMON_EXPORT void clearTestSuiteCache(KDevelop::IProject* project);
 }
 
 #endif
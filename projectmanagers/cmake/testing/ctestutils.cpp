@@ -23,12 +23,11 @@
 
 #include "ctestutils.h"
 #include "ctestsuite.h"
-#include "ctestfindjob.h"
 #include <debug.h>
 
 #include <interfaces/iproject.h>
 #include <interfaces/icore.h>
-#include <interfaces/iruncontroller.h>
+#include <interfaces/itestcontroller.h>
 #include <project/interfaces/ibuildsystemmanager.h>
 #include <project/projectmodel.h>
 #include <util/path.h>
@@ -38,32 +37,38 @@ using namespace KDevelop;
 
 #pragma message("TODO: we are lacking introspection into targets, to see what files belong to each target.")
 
-static CMakeTarget targetByName(const QHash< KDevelop::Path, QVector<CMakeTarget>>& targets, const QString& name)
+void CTestUtils::createTestSuites(const QVector<Test>& testSuites, const QHash< KDevelop::Path, QVector<CMakeTarget>>& targets, KDevelop::IProject* project)
 {
-    for (const auto &subdir: targets.values()) {
+    // look up the targets by name once instead of going through all of them for every test
+    QHash<QString, KDevelop::Path> executables;
+    for (const auto &subdir: targets) {
         for (const auto &target: subdir) {
-            if (target.name == name)
-                return target;
+            if (!target.artifacts.isEmpty() && !executables.contains(target.name))
+                executables.insert(target.name, target.artifacts.constFirst());
         }
     }
-    return {};
-}
 
-void CTestUtils::createTestSuites(const QVector<Test>& testSuites, const QHash< KDevelop::Path, QVector<CMakeTarget>>& targets, KDevelop::IProject* project)
-{
+    ITestController* testController = ICore::self()->testController();
     foreach (const Test& test, testSuites) {
         KDevelop::Path executablePath;
         if (QDir::isAbsolutePath(test.executable)) {
             executablePath = KDevelop::Path(test.executable);
         } else {
-            const auto target = targetByName(targets, test.executable);
-            if (target.artifacts.isEmpty()) {
+            executablePath = executables.value(test.executable);
+            if (executablePath.isEmpty()) {
                 continue;
             }
-            executablePath = target.artifacts.constFirst();
         }
 
+        auto existing = dynamic_cast<CTestSuite*>(testController->findTestSuite(project, test.name));
+        if (existing && existing->executable() == executablePath && existing->arguments() == test.arguments
+            && existing->properties() == test.properties) {
+            // unchanged since the last import, keep the suite and its test view entry
+            continue;
+        }
+
+        // the source files of the targets are not known, so there is nothing a CTestFindJob could parse
         CTestSuite* suite = new CTestSuite(test.name, executablePath, {}, project, test.arguments, test.properties);
-        ICore::self()->runController()->registerJob(new CTestFindJob(suite));
+        testController->addTestSuite(suite);
     }
 }
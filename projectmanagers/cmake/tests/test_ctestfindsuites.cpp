@@ -33,6 +33,7 @@
 #include <interfaces/iprojectcontroller.h>
 #include <interfaces/iproject.h>
 #include <testing/ctestsuite.h>
+#include <testing/ctestutils.h>
 #include <tests/autotestshell.h>
 #include <tests/testcore.h>
 #include <project/projectmodel.h>
@@ -113,4 +114,34 @@ void TestCTestFindSuites::testCTestSuite()
     }
 }
 
+void TestCTestFindSuites::testReimportSuites()
+{
+    IProject* project = loadProject( "unit_tests" );
+    QVERIFY2(project, "Project was not opened");
+    waitForSuites(project, 5, 10);
+
+    auto testController = ICore::self()->testController();
+    auto suite = static_cast<CTestSuite*>(testController->findTestSuite(project, QStringLiteral("fail")));
+    QVERIFY(suite);
+
+    Test test;
+    test.name = suite->name();
+    test.executable = suite->executable().toLocalFile();
+    test.arguments = suite->arguments();
+    test.properties = suite->properties();
+
+    // an unchanged test keeps its suite
+    CTestUtils::createTestSuites({test}, {}, project);
+    QCOMPARE(testController->findTestSuite(project, test.name), static_cast<ITestSuite*>(suite));
+    QCOMPARE(testController->testSuitesForProject(project).size(), 5);
+
+    // a changed one replaces it
+    test.arguments << QStringLiteral("-functions");
+    CTestUtils::createTestSuites({test}, {}, project);
+    suite = static_cast<CTestSuite*>(testController->findTestSuite(project, test.name));
+    QVERIFY(suite);
+    QCOMPARE(suite->arguments(), test.arguments);
+    QCOMPARE(testController->testSuitesForProject(project).size(), 5);
+}
+
 QTEST_MAIN(TestCTestFindSuites)
@@ -28,10 +28,14 @@
 #include <cstdio>
 #include <iostream>
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDir>
 #include <QFileInfo>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QRegExp>
+#include <QStandardPaths>
 
 #include <kprocess.h>
 #include <KLocalizedString>
@@ -72,11 +76,114 @@ namespace {
     bool failed;
     QMap<QString,bool> failedFiles;
     QDateTime failTime;
+    ///The flags of the single source files, by absolute path, if make could tell them apart
+    QHash<QString, PathResolutionResult> files;
   };
   typedef QMap<QString, CacheEntry> Cache;
 
   static Cache s_cache;
   static QMutex s_cacheMutex;
+
+  ///Files of the directory that are resolved together with one make call
+  static const int maxFilesPerMakeCall = 100;
+
+  ///Bump this when the format of the persistent cache changes
+  static const quint32 persistentCacheVersion = 1;
+
+  QString persistentCacheDirectory()
+  {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/makefileresolver");
+  }
+
+  QString persistentCacheFile(const QString& directory)
+  {
+    return persistentCacheDirectory() + QLatin1Char('/')
+         + QString::fromLatin1(QCryptographicHash::hash(directory.toUtf8(), QCryptographicHash::Sha1).toHex());
+  }
+
+  qint64 modificationTime(const QString& file)
+  {
+    return QFileInfo(file).lastModified().toMSecsSinceEpoch();
+  }
+
+  QStringList toStringList(const Path::List& paths)
+  {
+    QStringList ret;
+    ret.reserve(paths.size());
+    foreach (const Path& path, paths) {
+      ret << path.toLocalFile();
+    }
+    return ret;
+  }
+
+  void writeFlags(QDataStream& stream, const Path::List& paths, const Path::List& frameworkDirectories, const QHash<QString, QString>& defines)
+  {
+    stream << toStringList(paths) << toStringList(frameworkDirectories) << defines;
+  }
+
+  void readFlags(QDataStream& stream, Path::List* paths, Path::List* frameworkDirectories, QHash<QString, QString>* defines)
+  {
+    QStringList pathStrings, frameworkStrings;
+    stream >> pathStrings >> frameworkStrings >> *defines;
+    *paths = KDevelop::toPathList(pathStrings);
+    *frameworkDirectories = KDevelop::toPathList(frameworkStrings);
+  }
+
+  ///Stores the successful result for @p directory, so it survives a restart as long as @p makeFile doesn't change
+  ///Must be called with s_cacheMutex locked
+  void savePersistentCacheEntry(const QString& directory, const QString& makeFile, const CacheEntry& entry)
+  {
+    QDir().mkpath(persistentCacheDirectory());
+    QSaveFile file(persistentCacheFile(directory));
+    if (!file.open(QIODevice::WriteOnly)) {
+      return;
+    }
+
+    QDataStream stream(&file);
+    stream << persistentCacheVersion << directory << modificationTime(makeFile);
+    writeFlags(stream, entry.paths, entry.frameworkDirectories, entry.defines);
+    stream << entry.files.size();
+    for (auto it = entry.files.constBegin(); it != entry.files.constEnd(); ++it) {
+      stream << it.key();
+      writeFlags(stream, it->paths, it->frameworkDirectories, it->defines);
+    }
+    if (stream.status() == QDataStream::Ok) {
+      file.commit();
+    }
+  }
+
+  bool loadPersistentCacheEntry(const QString& directory, const QString& makeFile, CacheEntry* entry)
+  {
+    QFile file(persistentCacheFile(directory));
+    if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 version;
+    QString storedDirectory;
+    qint64 storedTime;
+    stream >> version;
+    if (version != persistentCacheVersion) {
+      return false;
+    }
+    stream >> storedDirectory >> storedTime;
+    if (storedDirectory != directory || storedTime != modificationTime(makeFile)) {
+      return false;
+    }
+
+    readFlags(stream, &entry->paths, &entry->frameworkDirectories, &entry->defines);
+    int fileCount;
+    stream >> fileCount;
+    for (int i = 0; i < fileCount && stream.status() == QDataStream::Ok; ++i) {
+      QString fileName;
+      stream >> fileName;
+      PathResolutionResult& result = entry->files[fileName];
+      result.success = true;
+      readFlags(stream, &result.paths, &result.frameworkDirectories, &result.defines);
+    }
+    return stream.status() == QDataStream::Ok;
+  }
 }
 
   /**
@@ -99,6 +206,20 @@ namespace {
       return "make -k --no-print-directory -W \'" + absoluteFile + "\' -W \'" + relativeFile + "\' -n " + makeParameters;
     }
 
+    ///Command to print the compile commands of all @p absoluteFiles, which are in one directory, with one make call
+    QStringList getBatchCommand(const QStringList& absoluteFiles, const QString& workingDirectory) const
+    {
+      QStringList ret{QStringLiteral("make"), QStringLiteral("-k"), QStringLiteral("--no-print-directory"), QStringLiteral("-n")};
+      QStringList targets;
+      for (const QString& absoluteFile : absoluteFiles) {
+        ret << QStringLiteral("-W") << absoluteFile;
+        ret << QStringLiteral("-W") << Path(workingDirectory).relativePath(Path(absoluteFile));
+        QFileInfo fi(absoluteFile);
+        targets += possibleTargets(fi.completeBaseName());
+      }
+      return ret + targets;
+    }
+
     bool hasMakefile() const
     {
         QFileInfo makeFile(m_path, QStringLiteral("Makefile"));
@@ -174,14 +295,19 @@ ModificationRevisionSet MakeFileResolver::findIncludePathDependency(const QStrin
 
 bool MakeFileResolver::executeCommand(const QString& command, const QString& workingDirectory, QString& result) const
 {
-  ifTest(cout << "executing " << command.toUtf8().constData() << endl);
+  return executeCommand(command.split(' '), workingDirectory, result);
+}
+
+bool MakeFileResolver::executeCommand(const QStringList& command, const QString& workingDirectory, QString& result) const
+{
+  ifTest(cout << "executing " << command.join(' ').toUtf8().constData() << endl);
   ifTest(cout << "in " << workingDirectory.toUtf8().constData() << endl);
 
   KProcess proc;
   proc.setWorkingDirectory(workingDirectory);
   proc.setOutputChannelMode(KProcess::MergedChannels);
 
-  QStringList args(command.split(' '));
+  QStringList args(command);
   QString prog = args.takeFirst();
   proc.setProgram(prog, args);
 
@@ -225,6 +351,7 @@ void MakeFileResolver::clearCache()
 {
   QMutexLocker l(&s_cacheMutex);
   s_cache.clear();
+  QDir(persistentCacheDirectory()).removeRecursively();
 }
 
 PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, const QString& _workingDirectory, int maxStepsUp)
@@ -284,6 +411,11 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
 
   PushValue<bool> e(m_isResolving, true);
 
+  QString absoluteFile = file;
+  if (QFileInfo(file).isRelative())
+    absoluteFile = workingDirectory + '/' + file;
+  absoluteFile = QDir::cleanPath(absoluteFile);
+
   Path::List cachedPaths; //If the call doesn't succeed, use the cached not up-to-date version
   Path::List cachedFWDirs;
   QHash<QString, QString> cachedDefines;
@@ -294,11 +426,26 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
   {
     QMutexLocker l(&s_cacheMutex);
     it = s_cache.find(dir.path());
+    if (it == s_cache.end()) {
+      //Maybe the directory has been resolved in an earlier session
+      CacheEntry entry;
+      if (loadPersistentCacheEntry(dir.path(), makeFile.filePath(), &entry)) {
+        entry.modificationTime = dependency;
+        it = s_cache.insert(dir.path(), entry);
+      }
+    }
     if (it != s_cache.end()) {
       cachedPaths = it->paths;
       cachedFWDirs = it->frameworkDirectories;
       cachedDefines = it->defines;
       if (dependency == it->modificationTime) {
+        auto fileIt = it->files.constFind(absoluteFile);
+        if (fileIt != it->files.constEnd()) {
+          //The file has been resolved together with its directory
+          PathResolutionResult ret = *fileIt;
+          ret.mergeWith(resultOnFail);
+          return ret;
+        }
         if (!it->failed) {
           //We have a valid cached result
           PathResolutionResult ret(true);
@@ -328,12 +475,6 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
 
   ///STEP 1: Prepare paths
   QString targetName;
-  QFileInfo fi(file);
-
-  QString absoluteFile = file;
-  if (fi.isRelative())
-    absoluteFile = workingDirectory + '/' + file;
-  absoluteFile = QDir::cleanPath(absoluteFile);
 
   int dot;
   if ((dot = file.lastIndexOf('.')) == -1) {
@@ -355,12 +496,24 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
   SourcePathInformation source(wd);
   QStringList possibleTargets = source.possibleTargets(targetName);
 
+  ///STEP 2: Resolve all source files of the directory at once, so they don't need a make call each
+  const QHash<QString, PathResolutionResult> fileResults = resolveDirectory(workingDirectory, wd, source);
+  PathResolutionResult res = fileResults.value(absoluteFile);
+
   ///STEP 3: Try resolving the paths, by using once the absolute and once the relative file-path. Which kind is required differs from setup to setup.
 
   ///STEP 3.1: Try resolution using the absolute path
-  PathResolutionResult res;
-  //Try for each possible target
-  res = resolveIncludePathInternal(absoluteFile, wd, possibleTargets.join(QStringLiteral(" ")), source, maximumInternalResolutionDepth);
+  if (!res) {
+    //Try for each possible target
+    res = resolveIncludePathInternal(absoluteFile, wd, possibleTargets.join(QStringLiteral(" ")), source, maximumInternalResolutionDepth);
+  }
+  //What the source files of the directory are compiled with, used for the other files like headers
+  PathResolutionResult directoryResult(!fileResults.isEmpty());
+  foreach (const PathResolutionResult& fileResult, fileResults) {
+    directoryResult.mergeWith(fileResult);
+  }
+  if (!res && directoryResult)
+    res = directoryResult;
   if (!res) {
     ifTest(cout << "Try for absolute file " << absoluteFile.toLocal8Bit().data() << " and targets " << possibleTargets.join(", ").toLocal8Bit().data()
                  << " failed: " << res.longErrorMessage.toLocal8Bit().data() << endl;)
@@ -383,9 +536,12 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
       it = s_cache.insert(dir.path(), CacheEntry());
 
     CacheEntry& ce(*it);
-    ce.paths = res.paths;
-    ce.frameworkDirectories = res.frameworkDirectories;
+    const PathResolutionResult& cached = directoryResult ? directoryResult : res;
+    ce.paths = cached.paths;
+    ce.frameworkDirectories = cached.frameworkDirectories;
+    ce.defines = cached.defines;
     ce.modificationTime = dependency;
+    ce.files = fileResults;
 
     if (!res) {
       ce.failed = true;
@@ -396,6 +552,7 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
     } else {
       ce.failed = false;
       ce.failedFiles.clear();
+      savePersistentCacheEntry(dir.path(), makeFile.filePath(), ce);
     }
   }
 
@@ -406,6 +563,62 @@ PathResolutionResult MakeFileResolver::resolveIncludePath(const QString& file, c
   return res;
 }
 
+QHash<QString, PathResolutionResult> MakeFileResolver::resolveDirectory(const QString& sourceDirectory, const QString& workingDirectory,
+                                                                        const SourcePathInformation& source) const
+{
+  static const QStringList sourceFilters = {
+    QStringLiteral("*.c"), QStringLiteral("*.cc"), QStringLiteral("*.cpp"), QStringLiteral("*.cxx"),
+    QStringLiteral("*.c++"), QStringLiteral("*.C"), QStringLiteral("*.m"), QStringLiteral("*.mm")
+  };
+
+  QHash<QString, PathResolutionResult> ret;
+
+  const QDir dir(sourceDirectory);
+  QStringList files;
+  foreach (const QString& fileName, dir.entryList(sourceFilters, QDir::Files)) {
+    files << QDir::cleanPath(dir.absoluteFilePath(fileName));
+  }
+
+  for (int i = 0; i < files.size(); i += maxFilesPerMakeCall) {
+    const QStringList batch = files.mid(i, maxFilesPerMakeCall);
+
+    //The compile commands may name the files in various ways, e.g. relative to the build directory
+    QHash<QString, QString> fileForName;
+    foreach (const QString& file, batch) {
+      fileForName.insert(QFileInfo(file).fileName(), file);
+    }
+
+    QString fullOutput;
+    executeCommand(source.getBatchCommand(batch, workingDirectory), workingDirectory, fullOutput);
+    fullOutput.remove(QStringLiteral("\\\n"));
+
+    foreach (const QString& line, fullOutput.split('\n', QString::SkipEmptyParts)) {
+      QString file;
+      foreach (QString token, line.split(' ', QString::SkipEmptyParts)) {
+        token.remove('\'').remove('"');
+        file = fileForName.value(token.mid(token.lastIndexOf('/') + 1));
+        if (!file.isEmpty())
+          break;
+      }
+      if (file.isEmpty())
+        continue;
+
+      //Lines without include paths are recursive make calls or don't compile anything
+      const PathResolutionResult result = processOutput(line + ' ', workingDirectory);
+      if (result.paths.isEmpty() && result.frameworkDirectories.isEmpty())
+        continue;
+
+      auto it = ret.find(file);
+      if (it == ret.end())
+        ret.insert(file, result);
+      else
+        it->mergeWith(result);
+    }
+  }
+
+  return ret;
+}
+
 static QRegularExpression includeRegularExpression()
 {
   static const QRegularExpression expression(
@@ -23,6 +23,7 @@
 #ifndef INCLUDEPATHRESOLVER_H
 #define INCLUDEPATHRESOLVER_H
 
+#include <QHash>
 #include <QString>
 
 #include <language/editor/modificationrevisionset.h>
@@ -66,6 +67,7 @@ class MakeFileResolver
     ///resets to in-source build system
     void resetOutOfSourceBuild();
 
+    ///Drops the cached results, including the ones stored on disk
     static void clearCache();
 
     KDevelop::ModificationRevisionSet findIncludePathDependency(const QString& file);
@@ -85,6 +87,11 @@ class MakeFileResolver
 
     ///Executes the command using KProcess
     bool executeCommand( const QString& command, const QString& workingDirectory, QString& result ) const;
+    bool executeCommand( const QStringList& command, const QString& workingDirectory, QString& result ) const;
+    ///Runs make for all source files in @p sourceDirectory at once, with a few make calls at most.
+    ///@return the results of the files make printed a compile command with include paths for, by absolute path
+    QHash<QString, PathResolutionResult> resolveDirectory( const QString& sourceDirectory, const QString& workingDirectory,
+                                                           const SourcePathInformation& source ) const;
     ///file should be the name of the target, without extension(because that may be different)
     PathResolutionResult resolveIncludePathInternal( const QString& file, const QString& workingDirectory,
                                                       const QString& makeParameters, const SourcePathInformation& source, int maxDepth );
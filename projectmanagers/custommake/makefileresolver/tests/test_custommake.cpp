@@ -21,7 +21,9 @@
 
 #include "test_custommake.h"
 
+#include <QDir>
 #include <QFile>
+#include <QStandardPaths>
 #include <QTextStream>
 #include <QDebug>
 #include <QTemporaryDir>
@@ -47,6 +49,7 @@ void createFile( QFile& file )
 
 void TestCustomMake::initTestCase()
 {
+    QStandardPaths::setTestModeEnabled(true);
     AutoTestShell::init();
     TestCore::initialize(Core::NoUi);
 }
@@ -105,6 +108,46 @@ void TestCustomMake::testFrameworkDirectories()
     QVERIFY(result.frameworkDirectories.contains(Path("/Library/Frameworks")));
 }
 
+void TestCustomMake::testFilesOfDirectory()
+{
+    QTemporaryDir tempDir;
+    {
+        QFile file( tempDir.path() + "/Makefile" );
+        createFile( file );
+        for (const QString& name : {QStringLiteral("a.cpp"), QStringLiteral("b.cpp"), QStringLiteral("c.h")}) {
+            QFile sourceFile( tempDir.path() + '/' + name );
+            createFile( sourceFile );
+        }
+        QTextStream stream1( &file );
+        stream1 << "a.o:\n\t g++ -c a.cpp -I/pathA -DA -o a.o\n"
+                   "b.o:\n\t g++ -c b.cpp -I/pathB -DB -o b.o\n";
+    }
+
+    MakeFileResolver mf;
+    auto result = mf.resolveIncludePath(tempDir.path() + "/a.cpp");
+    QVERIFY(result.success);
+    QCOMPARE(result.paths, Path::List{Path("/pathA")});
+    QVERIFY(result.defines.contains("A"));
+    QVERIFY(!result.defines.contains("B"));
+
+    // resolved together with a.cpp, but still with its own flags
+    result = mf.resolveIncludePath(tempDir.path() + "/b.cpp");
+    QVERIFY(result.success);
+    QCOMPARE(result.paths, Path::List{Path("/pathB")});
+    QVERIFY(result.defines.contains("B"));
+    QVERIFY(!result.defines.contains("A"));
+
+    // the flags of a header are taken from all source files of the directory
+    MakeFileResolver::clearCache();
+    const QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/makefileresolver");
+    QVERIFY(cacheDir.entryList(QDir::Files).isEmpty());
+    result = mf.resolveIncludePath(tempDir.path() + "/c.h");
+    QVERIFY(result.success);
+    QCOMPARE(result.paths.size(), 2);
+    QVERIFY(result.paths.contains(Path("/pathA")));
+    QVERIFY(result.paths.contains(Path("/pathB")));
+}
+
 void TestCustomMake::testDefines()
 {
     MakeFileResolver mf;
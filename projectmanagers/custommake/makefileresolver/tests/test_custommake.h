@@ -33,6 +33,7 @@ private Q_SLOTS:
     void cleanupTestCase();
     void testIncludeDirectories();
     void testFrameworkDirectories();
+    void testFilesOfDirectory();
     void testDefines();
 };
 
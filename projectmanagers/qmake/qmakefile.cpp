@@ -20,8 +20,15 @@
 
 #include "qmakefile.h"
 
+#include <QAtomicInt>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QtConcurrentRun>
 
 #include <debug.h>
 #include "parser/ast.h"
@@ -84,9 +91,107 @@ QStringList resolveShellGlobbingInternal(const QString& pattern, const QString&
     return resolveShellGlobbingInternal(pattern.split(QLatin1Char('/'), QString::SkipEmptyParts), dir_);
 }
 
+namespace {
+
+using ProjectASTPtr = QSharedPointer<QMake::ProjectAST>;
+
+struct CachedAST
+{
+    QDateTime lastModified;
+    qint64 size;
+    QFuture<ProjectASTPtr> ast;
+    // the projects that use the file, it is dropped from the cache once all of them are closed
+    QSet<KDevelop::IProject*> projects;
+};
+
+// .pri files and mkspecs are included by many project files, parse every file only once
+QMutex astCacheMutex;
+QHash<QString, CachedAST> astCache;
+QAtomicInt parsedFiles;
+
+ProjectASTPtr parseFile(const QString& fileName)
+{
+    parsedFiles.ref();
+
+    QMake::Driver d;
+    d.readFile(fileName);
+
+    QMake::ProjectAST* ast = nullptr;
+    if (!d.parse(&ast)) {
+        delete ast;
+        return {};
+    }
+    return ProjectASTPtr(ast);
+}
+
+/// @return the cached AST of @p fileName, the file gets parsed in the background when it changed
+QFuture<ProjectASTPtr> cachedAST(const QString& fileName, KDevelop::IProject* project)
+{
+    const QFileInfo info(fileName);
+    const QDateTime lastModified = info.lastModified();
+    const qint64 size = info.size();
+
+    QMutexLocker lock(&astCacheMutex);
+    auto it = astCache.find(fileName);
+    if (it == astCache.end() || it->lastModified != lastModified || it->size != size) {
+        it = astCache.insert(fileName, {lastModified, size, QtConcurrent::run(parseFile, fileName), {}});
+    }
+    it->projects.insert(project);
+    return it->ast;
+}
+
+QString projectFileInDirectory(const QString& path)
+{
+    const QFileInfo fi(path);
+    const QStringList l = QDir(path).entryList(QStringList() << QStringLiteral("*.pro"));
+
+    QString projectfile;
+
+    if (!l.count() || (l.count() && l.indexOf(fi.baseName() + ".pro") != -1)) {
+        projectfile = fi.baseName() + ".pro";
+    } else {
+        projectfile = l.first();
+    }
+    return path + '/' + projectfile;
+}
+
+}
+
+void QMakeFile::parseInBackground(KDevelop::IProject* project, const QStringList& paths)
+{
+    for (const QString& path : paths) {
+        if (QFileInfo(path).isDir()) {
+            // the import reads all project files in a sub directory
+            const QDir dir(path);
+            foreach (const QString& file, dir.entryList(QStringList() << QStringLiteral("*.pro"), QDir::Files)) {
+                cachedAST(dir.filePath(file), project);
+            }
+        } else {
+            cachedAST(path, project);
+        }
+    }
+}
+
+void QMakeFile::releaseProject(KDevelop::IProject* project)
+{
+    QMutexLocker lock(&astCacheMutex);
+    for (auto it = astCache.begin(); it != astCache.end();) {
+        it->projects.remove(project);
+        if (it->projects.isEmpty()) {
+            it = astCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int QMakeFile::parsedFileCount()
+{
+    return parsedFiles.load();
+}
+
 QMakeFile::QMakeFile(QString file)
-    : m_ast(nullptr)
-    , m_projectFile(std::move(file))
+    : m_projectFile(std::move(file))
     , m_project(nullptr)
 {
     Q_ASSERT(!m_projectFile.isEmpty());
@@ -98,32 +203,19 @@ bool QMakeFile::read()
     QFileInfo fi(m_projectFile);
     ifDebug(qCDebug(KDEV_QMAKE) << "Is" << m_projectFile << "a dir?" << fi.isDir();) if (fi.isDir())
     {
-        QDir dir(m_projectFile);
-        QStringList l = dir.entryList(QStringList() << QStringLiteral("*.pro"));
-
-        QString projectfile;
-
-        if (!l.count() || (l.count() && l.indexOf(fi.baseName() + ".pro") != -1)) {
-            projectfile = fi.baseName() + ".pro";
-        } else {
-            projectfile = l.first();
-        }
-        m_projectFile += '/' + projectfile;
+        m_projectFile = projectFileInDirectory(m_projectFile);
     }
-    QMake::Driver d;
-    d.readFile(m_projectFile);
 
-    if (!d.parse(&m_ast)) {
+    m_ast = cachedAST(m_projectFile, m_project).result();
+    if (!m_ast) {
         qCWarning(KDEV_QMAKE) << "Couldn't parse project:" << m_projectFile;
-        delete m_ast;
-        m_ast = nullptr;
         m_projectFile = QString();
         return false;
     } else {
         ifDebug(qCDebug(KDEV_QMAKE) << "found ast:" << m_ast->statements.count();) QMakeFileVisitor visitor(this, this);
         /// TODO: cleanup, re-use m_variableValues directly in the visitor
         visitor.setVariables(m_variableValues);
-        m_variableValues = visitor.visitFile(m_ast);
+        m_variableValues = visitor.visitFile(m_ast.data());
         ifDebug(qCDebug(KDEV_QMAKE) << "Variables found:" << m_variableValues;)
     }
     return true;
@@ -131,8 +223,6 @@ bool QMakeFile::read()
 
 QMakeFile::~QMakeFile()
 {
-    delete m_ast;
-    m_ast = nullptr;
 }
 
 QString QMakeFile::absoluteDir() const
@@ -147,7 +237,7 @@ QString QMakeFile::absoluteFile() const
 
 QMake::ProjectAST* QMakeFile::ast() const
 {
-    return m_ast;
+    return m_ast.data();
 }
 
 QStringList QMakeFile::variables() const
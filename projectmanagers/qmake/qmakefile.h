@@ -24,6 +24,8 @@
 
 #include <util/stack.h>
 
+#include <QSharedPointer>
+
 #include "qmakefilevisitor.h"
 
 class QStringList;
@@ -62,6 +64,22 @@ public:
     /// required for proper build-dir resolution
     void setProject(KDevelop::IProject* project);
     KDevelop::IProject* project() const;
+
+    /**
+     * Start parsing the given files of @p project, or the .pro files in the given
+     * directories, in the background.
+     *
+     * Parsed files are cached by path and modification time and shared by all
+     * QMakeFile instances, a later read() of one of the files only evaluates it.
+     * The cache keeps a file as long as one of the projects that use it is open.
+     */
+    static void parseInBackground(KDevelop::IProject* project, const QStringList& paths);
+
+    /// Drops the parsed files from the cache that no other project than @p project uses
+    static void releaseProject(KDevelop::IProject* project);
+
+    /// @return how many files were parsed so far, files taken from the cache are not counted
+    static int parsedFileCount();
 protected:
     VariableMap m_variableValues;
 
@@ -69,7 +87,8 @@ protected:
     QStringList resolveFileName( const QString& file, const QString& base = {} ) const;
     QString resolveToSingleFileName( const QString& file, const QString& base = {} ) const;
 private:
-    QMake::ProjectAST* m_ast;
+    // shared with other QMakeFile instances for the same file, must not be modified
+    QSharedPointer<QMake::ProjectAST> m_ast;
     QString m_projectFile;
     KDevelop::IProject* m_project;
 };
@@ -70,6 +70,14 @@ QMakeFolderItem* findQMakeFolderParent(ProjectBaseItem* item)
     return p;
 }
 
+/// the import reads the subprojects of @p pro next, parse them in parallel meanwhile
+void parseSubProjectsInBackground(QMakeProjectFile* pro)
+{
+    if (pro->getTemplate() == QLatin1String("subdirs")) {
+        QMakeFile::parseInBackground(pro->project(), pro->subProjects());
+    }
+}
+
 // END Helpers
 
 K_PLUGIN_FACTORY_WITH_JSON(QMakeSupportFactory, "kdevqmakemanager.json", registerPlugin<QMakeProjectManager>();)
@@ -100,6 +108,9 @@ QMakeProjectManager::QMakeProjectManager(QObject* parent, const QVariantList&)
 
     m_runQMake = new QAction(QIcon::fromTheme(QStringLiteral("qtlogo")), i18n("Run QMake"), this);
     connect(m_runQMake, &QAction::triggered, this, &QMakeProjectManager::slotRunQMake);
+
+    connect(core()->projectController(), &IProjectController::projectClosing,
+            this, &QMakeProjectManager::projectClosing);
 }
 
 QMakeProjectManager::~QMakeProjectManager()
@@ -107,6 +118,11 @@ QMakeProjectManager::~QMakeProjectManager()
     m_self = nullptr;
 }
 
+void QMakeProjectManager::projectClosing(IProject* project)
+{
+    QMakeFile::releaseProject(project);
+}
+
 IProjectFileManager::Features QMakeProjectManager::features() const
 {
     return Features(Folders | Targets | Files);
@@ -189,6 +205,7 @@ ProjectFolderItem* QMakeProjectManager::projectRootItem(IProject* project, const
         }
         scope->read();
         qCDebug(KDEV_QMAKE) << "top-level scope with variables:" << scope->variables();
+        parseSubProjectsInBackground(scope);
         item->addProjectFile(scope);
     }
     return item;
@@ -263,6 +280,7 @@ ProjectFolderItem* QMakeProjectManager::buildFolderItem(IProject* project, const
         }
 
         if (qmscope->read()) {
+            parseSubProjectsInBackground(qmscope);
             // TODO: only on read?
             folderItem->addProjectFile(qmscope);
         } else {
@@ -89,6 +89,7 @@ private Q_SLOTS:
     void slotFolderAdded( KDevelop::ProjectFolderItem* folder );
     void slotRunQMake();
     void slotDirty(const QString& path);
+    void projectClosing(KDevelop::IProject* project);
 
 private:    
     KDevelop::ProjectFolderItem* projectRootItem( KDevelop::IProject* project, const KDevelop::Path& path );
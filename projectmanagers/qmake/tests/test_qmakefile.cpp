@@ -519,6 +519,74 @@ void TestQMakeFile::testInclude()
     QVERIFY(file.includeDirectories().contains(tempDir.path()));
 }
 
+void TestQMakeFile::testChangedFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.path() + "/changed.pro";
+
+    QFile proFile(fileName);
+    QVERIFY(proFile.open(QIODevice::WriteOnly));
+    proFile.write("SOURCES += a.cpp\n");
+    proFile.close();
+
+    // the parsed file is cached, also when it was parsed in the background
+    QMakeFile::parseInBackground(nullptr, QStringList() << tempDir.path());
+    for (int i = 0; i < 2; ++i) {
+        QMakeProjectFile file(fileName);
+        if (setDefaultMKSpec(file).isEmpty()) {
+            QSKIP("Problem querying QMake, skipping test function");
+        }
+        QVERIFY(file.read());
+        QCOMPARE(file.variableValues("SOURCES"), QStringList() << "a.cpp");
+    }
+
+    QVERIFY(proFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    proFile.write("SOURCES += a.cpp b.cpp\n");
+    proFile.close();
+
+    QMakeProjectFile file(fileName);
+    setDefaultMKSpec(file);
+    QVERIFY(file.read());
+    QCOMPARE(file.variableValues("SOURCES"), QStringList() << "a.cpp"
+                                                           << "b.cpp");
+}
+
+void TestQMakeFile::testSharedInclude()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QFile includeFile(tempDir.path() + "/shared.pri");
+    QVERIFY(includeFile.open(QIODevice::WriteOnly));
+    includeFile.write("DEFINES += SHARED_DEF\n");
+    includeFile.close();
+
+    for (const QString& name : {QStringLiteral("a"), QStringLiteral("b")}) {
+        QFile proFile(tempDir.path() + '/' + name + ".pro");
+        QVERIFY(proFile.open(QIODevice::WriteOnly));
+        proFile.write("SOURCES += " + name.toLatin1() + ".cpp\n"
+                      "include(shared.pri)\n");
+        proFile.close();
+    }
+
+    QMakeProjectFile a(tempDir.path() + "/a.pro");
+    if (setDefaultMKSpec(a).isEmpty()) {
+        QSKIP("Problem querying QMake, skipping test function");
+    }
+    QMakeProjectFile b(tempDir.path() + "/b.pro");
+    setDefaultMKSpec(b);
+
+    // a.pro, b.pro and shared.pri, the include file is parsed only once
+    const int parsed = QMakeFile::parsedFileCount();
+    QVERIFY(a.read());
+    QVERIFY(b.read());
+    QCOMPARE(QMakeFile::parsedFileCount() - parsed, 3);
+
+    QCOMPARE(a.variableValues("DEFINES"), QStringList() << "SHARED_DEF");
+    QCOMPARE(b.variableValues("DEFINES"), QStringList() << "SHARED_DEF");
+}
+
 void TestQMakeFile::globbing_data()
 {
     QTest::addColumn<QStringList>("files");
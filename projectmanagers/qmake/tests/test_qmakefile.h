@@ -46,6 +46,8 @@ private Q_SLOTS:
     void qtIncludeDirs();
 
     void testInclude();
+    void testChangedFile();
+    void testSharedInclude();
 
     void globbing_data();
     void globbing();